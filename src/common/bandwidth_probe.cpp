@@ -0,0 +1,117 @@
+#include "bandwidth_probe.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+const char* streamKernelName(StreamKernel kernel) {
+    static const char* names[STREAM_KERNEL_COUNT] = {"Copy", "Scale", "Triad", "Xor"};
+    return names[static_cast<size_t>(kernel)];
+}
+
+double BandwidthProfile::peak(StreamKernel kernel) const {
+    double best = 0;
+    for (const auto& s : samples) {
+        best = std::max(best, s.get(kernel));
+    }
+    return best;
+}
+
+double BandwidthProfile::at(int threads, StreamKernel kernel) const {
+    const BandwidthSample* match = nullptr;
+    for (const auto& s : samples) {
+        if (s.threads <= threads && (!match || s.threads > match->threads)) {
+            match = &s;
+        }
+    }
+    return match ? match->get(kernel) : peak(kernel);
+}
+
+namespace {
+
+template <typename Body>
+double timeKernel(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+BandwidthProfile measureBandwidth(const std::vector<int>& threadCounts,
+                                  size_t arrayBytes, int repetitions) {
+    const size_t n = std::max<size_t>(arrayBytes / sizeof(double), 1024);
+    std::unique_ptr<double[]> a(new double[n]);
+    std::unique_ptr<double[]> b(new double[n]);
+    std::unique_ptr<double[]> c(new double[n]);
+    double* pa = a.get();
+    double* pb = b.get();
+    double* pc = c.get();
+    const uint64_t key[4] = {0x0123456789abcdefULL, 0xfedcba9876543210ULL,
+                             0x0f1e2d3c4b5a6978ULL, 0x8796a5b4c3d2e1f0ULL};
+    const double scalar = 3.0;
+    const long long count = static_cast<long long>(n);
+
+    BandwidthProfile profile;
+
+    for (int threads : threadCounts) {
+#ifdef HAS_OPENMP
+        omp_set_num_threads(threads);
+#else
+        threads = 1;
+#endif
+
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < count; ++i) {
+            pa[i] = 1.0;
+            pb[i] = 2.0;
+            pc[i] = 0.0;
+        }
+
+        BandwidthSample sample;
+        sample.threads = threads;
+        std::array<double, STREAM_KERNEL_COUNT> best;
+        best.fill(1e30);
+
+        for (int rep = 0; rep < repetitions; ++rep) {
+            best[0] = std::min(best[0], timeKernel([&] {
+                #pragma omp parallel for schedule(static)
+                for (long long i = 0; i < count; ++i) pc[i] = pa[i];
+            }));
+            best[1] = std::min(best[1], timeKernel([&] {
+                #pragma omp parallel for schedule(static)
+                for (long long i = 0; i < count; ++i) pb[i] = scalar * pc[i];
+            }));
+            best[2] = std::min(best[2], timeKernel([&] {
+                #pragma omp parallel for schedule(static)
+                for (long long i = 0; i < count; ++i) pa[i] = pb[i] + scalar * pc[i];
+            }));
+            best[3] = std::min(best[3], timeKernel([&] {
+                #pragma omp parallel for schedule(static)
+                for (long long i = 0; i < count; ++i) {
+                    uint64_t v;
+                    std::memcpy(&v, pb + i, sizeof(v));
+                    v ^= key[i & 3];
+                    std::memcpy(pa + i, &v, sizeof(v));
+                }
+            }));
+        }
+
+        const double bytesPerElem[STREAM_KERNEL_COUNT] = {16, 16, 24, 16};
+        for (size_t k = 0; k < STREAM_KERNEL_COUNT; ++k) {
+            sample.gbs[k] = bytesPerElem[k] * n / best[k] / 1e9;
+        }
+        profile.samples.push_back(sample);
+    }
+
+    return profile;
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace hpc_benchmark {
+
+enum class StreamKernel {
+    Copy,
+    Scale,
+    Triad,
+    Xor
+};
+
+constexpr size_t STREAM_KERNEL_COUNT = 4;
+
+const char* streamKernelName(StreamKernel kernel);
+
+struct BandwidthSample {
+    int threads = 1;
+    std::array<double, STREAM_KERNEL_COUNT> gbs{};
+
+    double get(StreamKernel kernel) const { return gbs[static_cast<size_t>(kernel)]; }
+};
+
+struct BandwidthProfile {
+    std::vector<BandwidthSample> samples;
+
+    double peak(StreamKernel kernel) const;
+    double at(int threads, StreamKernel kernel) const;
+};
+
+// STREAM-style probe (best of `repetitions`) run once per thread count.
+// The Xor kernel reads one array and writes another XOR-ed with a repeating
+// 32-byte key, i.e. the same traffic as the XOR engines.
+BandwidthProfile measureBandwidth(const std::vector<int>& threadCounts,
+                                  size_t arrayBytes, int repetitions = 5);
+
+}
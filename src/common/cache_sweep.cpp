@@ -0,0 +1,189 @@
+#include "cache_sweep.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// sysfs cacheinfo sizes look like "48K", "2048K" or "32M".
+size_t parseCacheSize(const std::string& text) {
+    size_t pos = 0;
+    size_t value = std::stoul(text, &pos);
+    if (pos < text.size()) {
+        char unit = text[pos];
+        if (unit == 'K') value *= 1024;
+        else if (unit == 'M') value *= 1024 * 1024;
+        else if (unit == 'G') value *= 1024 * 1024 * 1024;
+    }
+    return value;
+}
+
+std::string labelFor(int level, const std::string& type) {
+    std::string label = "L" + std::to_string(level);
+    if (type == "Data") label += "d";
+    return label;
+}
+
+}
+
+std::vector<CacheLevel> detectCacheLevels() {
+    std::vector<CacheLevel> caches;
+#ifdef __linux__
+    for (int index = 0;; ++index) {
+        std::string base = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+        std::ifstream levelFile(base + "level");
+        std::ifstream typeFile(base + "type");
+        std::ifstream sizeFile(base + "size");
+        CacheLevel c;
+        std::string size;
+        if (!(levelFile >> c.level) || !(typeFile >> c.type) || !(sizeFile >> size)) break;
+        if (c.type == "Instruction") continue;
+        c.sizeBytes = parseCacheSize(size);
+        c.label = labelFor(c.level, c.type);
+        caches.push_back(c);
+    }
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    if (caches.empty()) {
+        const int names[] = {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL4_CACHE_SIZE};
+        for (int level = 1; level <= 4; ++level) {
+            long size = sysconf(names[level - 1]);
+            if (size <= 0) continue;
+            CacheLevel c;
+            c.level = level;
+            c.type = level == 1 ? "Data" : "Unified";
+            c.sizeBytes = static_cast<size_t>(size);
+            c.label = labelFor(c.level, c.type);
+            caches.push_back(c);
+        }
+    }
+#endif
+#endif
+
+    std::sort(caches.begin(), caches.end(), [](const CacheLevel& a, const CacheLevel& b) {
+        return a.level < b.level;
+    });
+    return caches;
+}
+
+std::string cacheLevelFor(const std::vector<CacheLevel>& caches, size_t bytes) {
+    for (const auto& c : caches) {
+        if (bytes <= c.sizeBytes) return c.label;
+    }
+    return "DRAM";
+}
+
+const char* cacheSweepModeName(CacheSweepMode mode) {
+    switch (mode) {
+        case CacheSweepMode::Warm: return "warm";
+        case CacheSweepMode::Flushed: return "flushed";
+    }
+    return "unknown";
+}
+
+std::vector<CacheSweepPoint> cacheSweepSizes(const std::vector<CacheLevel>& caches,
+                                             size_t alignment, size_t maxWorkingSet) {
+    const double fractions[] = {0.25, 0.5, 0.9, 1.25, 2.0};
+    std::vector<size_t> workingSets;
+    for (const auto& c : caches) {
+        for (double f : fractions) {
+            workingSets.push_back(static_cast<size_t>(c.sizeBytes * f));
+        }
+    }
+    if (!caches.empty()) {
+        workingSets.push_back(caches.back().sizeBytes * 4);
+    }
+
+    std::vector<size_t> sizes;
+    for (size_t ws : workingSets) {
+        if (ws > maxWorkingSet) ws = maxWorkingSet;
+        size_t bytes = std::max(ws / 2 / alignment * alignment, alignment);
+        sizes.push_back(bytes);
+    }
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+    std::vector<CacheSweepPoint> points;
+    for (size_t bytes : sizes) {
+        CacheSweepPoint p;
+        p.bytes = bytes;
+        p.workingSet = bytes * 2;
+        p.level = cacheLevelFor(caches, p.workingSet);
+        points.push_back(p);
+    }
+    return points;
+}
+
+CacheSweepResult measureCacheSweep(ICipherEngine& engine, const CacheSweepPoint& point,
+                                   CacheSweepMode mode, size_t poolBytes, double minSeconds) {
+    CacheSweepResult result;
+    result.algorithm = engine.getAlgorithmName();
+    result.engine = engine.getEngineName();
+    result.point = point;
+    result.mode = mode;
+
+    size_t pairs = 1;
+    if (mode == CacheSweepMode::Flushed) {
+        pairs = std::max<size_t>(2, (poolBytes + point.workingSet - 1) / point.workingSet);
+    }
+
+    // One allocation per direction so rotating never touches the allocator.
+    std::vector<uint8_t> input(point.bytes * pairs), output(point.bytes * pairs), key(MAX_KEY_BYTES), iv(16);
+    std::mt19937 gen(0xcac4e);
+    for (size_t i = 0; i < point.bytes; ++i) input[i] = static_cast<uint8_t>(gen());
+    for (size_t p = 1; p < pairs; ++p) {
+        std::copy(input.begin(), input.begin() + point.bytes, input.begin() + p * point.bytes);
+    }
+    for (auto& b : key) b = static_cast<uint8_t>(gen());
+    for (auto& b : iv) b = static_cast<uint8_t>(gen());
+    std::fill(output.begin(), output.end(), 0);
+
+    // Warm-up: faults in the output pages and, in Warm mode, loads the buffers.
+    engine.encrypt(input.data(), output.data(), point.bytes, key.data(), engine.getKeyBytes(), iv.data());
+
+    // Timed in batches so the clock read does not dominate L1-sized calls.
+    const size_t batch = std::max<size_t>(1, (256 * 1024) / point.bytes);
+    size_t next = 1 % pairs;
+    double elapsed = 0;
+    while (elapsed < minSeconds || result.calls < 3) {
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+            size_t offset = next * point.bytes;
+            engine.encrypt(input.data() + offset, output.data() + offset, point.bytes,
+                           key.data(), engine.getKeyBytes(), iv.data());
+            next = next + 1 == pairs ? 0 : next + 1;
+        }
+        elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+        result.calls += batch;
+    }
+
+    result.throughputMBs = (static_cast<double>(point.bytes) * result.calls) / (1024.0 * 1024.0) / elapsed;
+    return result;
+}
+
+void writeCacheSweepCsv(const std::vector<CacheSweepResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "Algorithm,Engine,Size_Bytes,Working_Set_Bytes,Cache_Level,Mode,Calls,Throughput_MBs\n";
+    for (const auto& r : results) {
+        file << r.algorithm << "," << r.engine << "," << r.point.bytes << "," << r.point.workingSet << ","
+             << r.point.level << "," << cacheSweepModeName(r.mode) << "," << r.calls << ","
+             << std::fixed << std::setprecision(2) << r.throughputMBs << "\n";
+    }
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+struct CacheLevel {
+    int level = 0;
+    std::string type;   // "Data" or "Unified"
+    size_t sizeBytes = 0;
+    std::string label;  // "L1d", "L2", "L3", ...
+};
+
+// Data and unified caches seen by cpu0, innermost first (sysfs cacheinfo,
+// else sysconf); empty when the platform exposes neither.
+std::vector<CacheLevel> detectCacheLevels();
+
+// Level a working set of `bytes` fits in, or "DRAM" beyond the last level.
+std::string cacheLevelFor(const std::vector<CacheLevel>& caches, size_t bytes);
+
+enum class CacheSweepMode {
+    Warm,    // same buffers every call
+    Flushed  // rotate through a pool larger than the LLC
+};
+
+const char* cacheSweepModeName(CacheSweepMode mode);
+
+struct CacheSweepPoint {
+    size_t bytes = 0;       // payload per encrypt() call
+    size_t workingSet = 0;  // input + output
+    std::string level;
+};
+
+// Payload sizes bracketing every cache level (1/4 .. 2x of its capacity as
+// input + output working set) plus one DRAM point, rounded to `alignment`.
+// Points whose working set exceeds maxWorkingSet are dropped.
+std::vector<CacheSweepPoint> cacheSweepSizes(const std::vector<CacheLevel>& caches,
+                                             size_t alignment, size_t maxWorkingSet);
+
+struct CacheSweepResult {
+    std::string algorithm;
+    std::string engine;
+    CacheSweepPoint point;
+    CacheSweepMode mode = CacheSweepMode::Warm;
+    size_t calls = 0;
+    double throughputMBs = 0;
+};
+
+// Encrypts point.bytes back to back for at least minSeconds. In Flushed mode
+// each call takes the next buffer pair of a pool of at least poolBytes, so
+// every call starts with its data evicted by the calls before it.
+CacheSweepResult measureCacheSweep(ICipherEngine& engine, const CacheSweepPoint& point,
+                                   CacheSweepMode mode, size_t poolBytes, double minSeconds);
+
+void writeCacheSweepCsv(const std::vector<CacheSweepResult>& results, const std::string& path);
+
+}
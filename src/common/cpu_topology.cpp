@@ -0,0 +1,207 @@
+#include "cpu_topology.hpp"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+int readInt(const std::string& path, int fallback) {
+    std::ifstream f(path);
+    int value;
+    if (f >> value) {
+        return value;
+    }
+    return fallback;
+}
+
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty()) continue;
+        size_t dash = range.find('-');
+        int lo = std::stoi(range.substr(0, dash));
+        int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+        for (int c = lo; c <= hi; ++c) {
+            cpus.push_back(c);
+        }
+    }
+    return cpus;
+}
+
+#ifdef __linux__
+bool setAffinity(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cpus) {
+        CPU_SET(c, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+#endif
+
+}
+
+int CpuTopology::packageCount() const {
+    std::set<int> packages;
+    for (const auto& c : cpus) packages.insert(c.package);
+    return static_cast<int>(packages.size());
+}
+
+int CpuTopology::physicalCoreCount() const {
+    std::set<std::pair<int, int>> cores;
+    for (const auto& c : cpus) cores.insert({c.package, c.core});
+    return static_cast<int>(cores.size());
+}
+
+int CpuTopology::smtWidth() const {
+    int width = 0;
+    for (const auto& c : cpus) width = std::max(width, c.smtIndex + 1);
+    return width;
+}
+
+CpuTopology CpuTopology::detect() {
+    CpuTopology topo;
+    std::vector<int> online;
+
+    std::ifstream onlineFile("/sys/devices/system/cpu/online");
+    std::string line;
+    if (onlineFile && std::getline(onlineFile, line)) {
+        online = parseCpuList(line);
+    }
+    if (online.empty()) {
+        int n = static_cast<int>(std::thread::hardware_concurrency());
+        for (int c = 0; c < std::max(n, 1); ++c) online.push_back(c);
+    }
+
+    std::map<std::pair<int, int>, int> siblingsSeen;
+    for (int cpu : online) {
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        CpuInfo info;
+        info.cpu = cpu;
+        info.core = readInt(base + "core_id", cpu);
+        info.package = readInt(base + "physical_package_id", 0);
+        info.smtIndex = siblingsSeen[{info.package, info.core}]++;
+        topo.cpus.push_back(info);
+    }
+    return topo;
+}
+
+AffinityPolicy parseAffinityPolicy(const std::string& name) {
+    if (name == "none") return AffinityPolicy::None;
+    if (name == "compact") return AffinityPolicy::Compact;
+    if (name == "scatter") return AffinityPolicy::Scatter;
+    if (name == "physical") return AffinityPolicy::Physical;
+    throw std::runtime_error("Unknown affinity policy: " + name + " (expected none, compact, scatter or physical)");
+}
+
+const char* affinityPolicyName(AffinityPolicy policy) {
+    switch (policy) {
+        case AffinityPolicy::Compact: return "compact";
+        case AffinityPolicy::Scatter: return "scatter";
+        case AffinityPolicy::Physical: return "physical";
+        default: return "none";
+    }
+}
+
+std::vector<int> selectCpus(const CpuTopology& topology, AffinityPolicy policy, int threads) {
+    if (policy == AffinityPolicy::None || threads <= 0) {
+        return {};
+    }
+
+    std::map<std::pair<int, int>, int> coreRank;
+    for (const auto& c : topology.cpus) coreRank[{c.package, c.core}] = 0;
+    std::map<int, int> nextRank;
+    for (auto& entry : coreRank) entry.second = nextRank[entry.first.first]++;
+
+    std::vector<CpuInfo> order = topology.cpus;
+    auto rank = [&](const CpuInfo& c) { return coreRank[{c.package, c.core}]; };
+
+    if (policy == AffinityPolicy::Scatter) {
+        std::sort(order.begin(), order.end(), [&](const CpuInfo& a, const CpuInfo& b) {
+            return std::make_tuple(a.smtIndex, rank(a), a.package) <
+                   std::make_tuple(b.smtIndex, rank(b), b.package);
+        });
+    } else {
+        if (policy == AffinityPolicy::Physical) {
+            order.erase(std::remove_if(order.begin(), order.end(),
+                                       [](const CpuInfo& c) { return c.smtIndex != 0; }),
+                        order.end());
+        }
+        std::sort(order.begin(), order.end(), [&](const CpuInfo& a, const CpuInfo& b) {
+            return std::make_tuple(a.package, rank(a), a.smtIndex) <
+                   std::make_tuple(b.package, rank(b), b.smtIndex);
+        });
+    }
+
+    if (static_cast<size_t>(threads) > order.size()) {
+        return {};
+    }
+
+    std::vector<int> cpus;
+    for (int i = 0; i < threads; ++i) {
+        cpus.push_back(order[i].cpu);
+    }
+    return cpus;
+}
+
+bool pinThreads(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) return false;
+    bool ok = true;
+#ifdef HAS_OPENMP
+    #pragma omp parallel num_threads(static_cast<int>(cpus.size())) reduction(&& : ok)
+    {
+        ok = setAffinity({cpus[omp_get_thread_num() % cpus.size()]});
+    }
+#endif
+    return setAffinity({cpus[0]}) && ok;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+void unpinThreads(const CpuTopology& topology) {
+#ifdef __linux__
+    std::vector<int> all;
+    for (const auto& c : topology.cpus) all.push_back(c.cpu);
+    if (all.empty()) return;
+#ifdef HAS_OPENMP
+    #pragma omp parallel
+    {
+        setAffinity(all);
+    }
+#endif
+    setAffinity(all);
+#else
+    (void)topology;
+#endif
+}
+
+std::string formatCpuList(const std::vector<int>& cpus) {
+    std::ostringstream ss;
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        if (i > 0) ss << " ";
+        ss << cpus[i];
+    }
+    return ss.str();
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+struct CpuInfo {
+    int cpu = 0;
+    int core = 0;
+    int package = 0;
+    int smtIndex = 0;
+};
+
+struct CpuTopology {
+    std::vector<CpuInfo> cpus;
+
+    int packageCount() const;
+    int physicalCoreCount() const;
+    int smtWidth() const;
+
+    static CpuTopology detect();
+};
+
+enum class AffinityPolicy {
+    None,
+    Compact,
+    Scatter,
+    Physical
+};
+
+AffinityPolicy parseAffinityPolicy(const std::string& name);
+const char* affinityPolicyName(AffinityPolicy policy);
+
+// Logical CPUs for `threads` workers under `policy`; empty if the policy
+// cannot place that many threads (e.g. Physical beyond the core count).
+std::vector<int> selectCpus(const CpuTopology& topology, AffinityPolicy policy, int threads);
+
+// Pins OpenMP thread i of a team of cpus.size() threads to cpus[i]. The
+// runtime reuses its pool for later teams of the same size, so engines that
+// open parallel regions with that thread count inherit the placement.
+bool pinThreads(const std::vector<int>& cpus);
+void unpinThreads(const CpuTopology& topology);
+
+std::string formatCpuList(const std::vector<int>& cpus);
+
+}
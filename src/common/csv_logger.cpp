@@ -18,7 +18,24 @@ CsvLogger::~CsvLogger() {
 
 void CsvLogger::writeHeader() {
     if (!headerWritten_) {
-        file_ << "Platform,Algorithm,Engine,FileSize_MB,NumThreads,Time_Sec,Throughput_MBs,Speedup,Efficiency,Verified,Energy_Joules,Power_Watts,Energy_Source\n";
+        file_ << "Platform,Algorithm,Engine,FileSize_MB,NumThreads,Time_Sec,Throughput_MBs,Speedup,Efficiency,Verified,Energy_Joules,Power_Watts,Energy_Source,"
+              << "Samples,Warmup,Time_Median_Sec,Time_Min_Sec,Time_P95_Sec,Time_Stddev_Sec,Time_CI95_Low_Sec,Time_CI95_High_Sec";
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            file_ << ",Phase_" << phaseName(static_cast<Phase>(i)) << "_Sec";
+        }
+        for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+            file_ << "," << hwEventName(static_cast<HwEvent>(i));
+        }
+        file_ << ",IPC,Cycles_Per_Byte,Bytes_Per_LLC_Miss";
+        file_ << ",Effective_BW_GBs,Attainable_BW_GBs,BW_Utilization";
+        file_ << ",Affinity,CPU_List";
+        file_ << ",Schedule,Chunk_Bytes";
+        for (size_t i = 0; i < ENERGY_DOMAIN_COUNT; ++i) {
+            file_ << ",Energy_" << energyDomainName(static_cast<EnergyDomain>(i)) << "_J";
+        }
+        file_ << ",Key_Bits";
+        file_ << ",Decrypt_Time_Median_Sec,Decrypt_Throughput_MBs,Decrypt_Speedup";
+        file_ << "\n";
         headerWritten_ = true;
     }
 }
@@ -40,7 +57,53 @@ void CsvLogger::writeResult(const BenchmarkResult& result) {
           << (result.verified ? "PASS" : "FAIL") << ","
           << std::fixed << std::setprecision(4) << result.energyJoules << ","
           << std::fixed << std::setprecision(2) << result.powerWatts << ","
-          << result.energySource << "\n";
+          << result.energySource << ","
+          << result.timeSamples.size() << ","
+          << result.warmupIterations << ","
+          << std::fixed << std::setprecision(6) << result.timeMedianSec << ","
+          << std::fixed << std::setprecision(6) << result.timeMinSec << ","
+          << std::fixed << std::setprecision(6) << result.timeP95Sec << ","
+          << std::fixed << std::setprecision(6) << result.timeStddevSec << ","
+          << std::fixed << std::setprecision(6) << result.timeCILowSec << ","
+          << std::fixed << std::setprecision(6) << result.timeCIHighSec;
+    for (double sec : result.phases.seconds) {
+        file_ << "," << std::fixed << std::setprecision(6) << sec;
+    }
+    
+    const HardwareCounters& hw = result.counters;
+    double bytes = static_cast<double>(result.fileSizeMB) * 1024 * 1024;
+    for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+        file_ << ",";
+        if (hw.valid[i]) file_ << std::fixed << std::setprecision(0) << hw.values[i];
+    }
+    file_ << ",";
+    if (hw.has(HwEvent::Cycles) && hw.has(HwEvent::Instructions)) file_ << std::fixed << std::setprecision(4) << hw.ipc();
+    file_ << ",";
+    if (hw.has(HwEvent::Cycles)) file_ << std::fixed << std::setprecision(4) << hw.cyclesPerByte(bytes);
+    file_ << ",";
+    if (hw.has(HwEvent::LlcMisses)) file_ << std::fixed << std::setprecision(2) << hw.bytesPerLlcMiss(bytes);
+    
+    file_ << "," << std::fixed << std::setprecision(3) << result.effectiveBandwidthGBs
+          << "," << std::fixed << std::setprecision(3) << result.attainableBandwidthGBs
+          << "," << std::fixed << std::setprecision(4) << result.bandwidthUtilization;
+    
+    file_ << "," << result.affinity << "," << result.cpuList;
+    file_ << "," << result.schedule << ",";
+    if (result.chunkBytes > 0) file_ << result.chunkBytes;
+    for (size_t i = 0; i < ENERGY_DOMAIN_COUNT; ++i) {
+        file_ << ",";
+        if (result.energyDomains.valid[i]) file_ << std::fixed << std::setprecision(4) << result.energyDomains.joules[i];
+    }
+    file_ << "," << result.keyBits;
+    file_ << ",";
+    if (result.decryptTimeMedianSec > 0) {
+        file_ << std::fixed << std::setprecision(6) << result.decryptTimeMedianSec << ","
+              << std::fixed << std::setprecision(2) << result.decryptThroughputMBs << ","
+              << std::fixed << std::setprecision(4) << result.decryptSpeedup;
+    } else {
+        file_ << ",";
+    }
+    file_ << "\n";
 }
 
 void CsvLogger::flush() {
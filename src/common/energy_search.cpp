@@ -0,0 +1,89 @@
+#include "energy_search.hpp"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+namespace {
+
+bool dominates(const EnergyPoint& a, const EnergyPoint& b) {
+    if (!a.energyValid || !b.energyValid) {
+        return a.throughputMBs > b.throughputMBs;
+    }
+    bool noWorse = a.throughputMBs >= b.throughputMBs && a.joulesPerGB <= b.joulesPerGB;
+    bool better = a.throughputMBs > b.throughputMBs || a.joulesPerGB < b.joulesPerGB;
+    return noWorse && better;
+}
+
+}
+
+void markParetoFrontier(std::vector<EnergyPoint>& points) {
+    for (auto& p : points) {
+        p.pareto = true;
+        for (const auto& q : points) {
+            if (&p != &q && dominates(q, p)) {
+                p.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+size_t energyOptimal(const std::vector<EnergyPoint>& points) {
+    size_t best = points.size();
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (!points[i].energyValid) continue;
+        if (best == points.size() || points[i].joulesPerGB < points[best].joulesPerGB) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+size_t latencyOptimal(const std::vector<EnergyPoint>& points) {
+    size_t best = points.size();
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].latencySec <= 0) continue;
+        if (best == points.size() || points[i].latencySec < points[best].latencySec) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void writeEnergyCsv(const std::vector<std::vector<EnergyPoint>>& groups, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "FileSize_MB,Algorithm,Engine,NumThreads,Affinity,Chunk_Bytes,Throughput_MBs,Latency_Median_Sec,"
+         << "Energy_Joules,Joules_Per_GB,Power_Watts,Pareto,Recommended\n";
+
+    for (const auto& points : groups) {
+        size_t energyBest = energyOptimal(points);
+        size_t latencyBest = latencyOptimal(points);
+        for (size_t i = 0; i < points.size(); ++i) {
+            const EnergyPoint& p = points[i];
+            std::string recommended = i == energyBest && i == latencyBest ? "energy+latency"
+                                    : i == energyBest ? "energy"
+                                    : i == latencyBest ? "latency" : "";
+            file << p.sizeMB << "," << p.algorithm << "," << p.engine << "," << p.threads << ","
+                 << p.affinity << ",";
+            if (p.chunkBytes > 0) file << p.chunkBytes;
+            file << "," << std::fixed << std::setprecision(2) << p.throughputMBs << ","
+                 << std::fixed << std::setprecision(6) << p.latencySec << ",";
+            if (p.energyValid) {
+                file << std::fixed << std::setprecision(4) << p.joules << ","
+                     << std::fixed << std::setprecision(3) << p.joulesPerGB << ","
+                     << std::fixed << std::setprecision(2) << p.watts;
+            } else {
+                file << ",,";
+            }
+            file << "," << (p.pareto ? "yes" : "no") << "," << recommended << "\n";
+        }
+    }
+}
+
+}
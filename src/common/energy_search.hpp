@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+struct EnergyPoint {
+    size_t sizeMB = 0;
+    std::string algorithm;
+    std::string engine;
+    std::string affinity = "none";
+    int threads = 1;
+    size_t chunkBytes = 0;
+    double throughputMBs = 0;
+    double latencySec = 0;
+    double joules = 0;
+    double joulesPerGB = 0;
+    double watts = 0;
+    bool energyValid = false;
+    bool pareto = false;
+};
+
+// Marks the points not dominated on (higher throughput, lower J/GB). Without
+// energy readings the frontier degenerates to the fastest point.
+void markParetoFrontier(std::vector<EnergyPoint>& points);
+
+// Index of the lowest J/GB (energy) or lowest per-call latency point;
+// points.size() if none qualifies.
+size_t energyOptimal(const std::vector<EnergyPoint>& points);
+size_t latencyOptimal(const std::vector<EnergyPoint>& points);
+
+void writeEnergyCsv(const std::vector<std::vector<EnergyPoint>>& groups, const std::string& path);
+
+}
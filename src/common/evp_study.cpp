@@ -0,0 +1,26 @@
+#include "evp_study.hpp"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+void writeEvpStudyCsv(const std::vector<EvpStudyResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "Algorithm,Engine,Fetch,Context,Threads,Call_Bytes,Throughput_MBs,Ns_Per_Call,"
+         << "Setup_Inits,Setup_Ns_Per_Init,Setup_Vs_1_Thread\n";
+    for (const auto& r : results) {
+        file << r.algorithm << "," << r.engine << "," << r.fetch << "," << r.context << "," << r.threads << ","
+             << r.callBytes << "," << std::fixed << std::setprecision(2) << r.throughputMBs << ","
+             << std::fixed << std::setprecision(1) << r.nsPerCall << "," << r.setupInits << ","
+             << std::fixed << std::setprecision(1) << r.setupNsPerInit << ",";
+        if (r.setupVsOneThread > 0) file << std::fixed << std::setprecision(3) << r.setupVsOneThread;
+        file << "\n";
+    }
+}
+
+}
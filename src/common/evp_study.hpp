@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// One measurement of an AES-CTR engine under one OpenSSL usage pattern
+// (see engines/aes/evp_usage.hpp).
+struct EvpStudyResult {
+    std::string algorithm;
+    std::string engine;
+    std::string fetch;    // "implicit", "process" or "libctx"
+    std::string context;  // "fresh" or "reset"
+    int threads = 1;
+    size_t callBytes = 0;
+    double throughputMBs = 0;
+    double nsPerCall = 0;
+    uint64_t setupInits = 0;     // context setups (new/reset + init) during the measurement
+    double setupNsPerInit = 0;   // mean time of one, per thread
+    double setupVsOneThread = 0; // setupNsPerInit over the same variant's 1-thread value
+};
+
+void writeEvpStudyCsv(const std::vector<EvpStudyResult>& results, const std::string& path);
+
+}
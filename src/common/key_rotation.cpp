@@ -0,0 +1,222 @@
+#include "key_rotation.hpp"
+#include "key_schedule_cache.hpp"
+#include "statistics.hpp"
+#include "verification.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Sets the shared cache capacity for one measurement and puts the
+// user's setting back afterwards.
+class CacheCapacityScope {
+public:
+    explicit CacheCapacityScope(size_t entries)
+        : cache_(KeyScheduleCache::shared()), saved_(cache_.getCapacity()) {
+        cache_.setCapacity(entries);
+    }
+    ~CacheCapacityScope() { cache_.setCapacity(saved_); }
+
+private:
+    KeyScheduleCache& cache_;
+    size_t saved_;
+};
+
+}
+
+KeyRotation::KeyRotation(size_t keyBytes, uint64_t intervalBytes, uint64_t streamBytes, uint64_t seed)
+    : keyBytes_(keyBytes), intervalBytes_(intervalBytes) {
+    if (keyBytes == 0 || intervalBytes == 0) {
+        throw std::runtime_error("Key rotation needs a key size and a non-zero interval");
+    }
+    size_t ranges = std::max<uint64_t>(1, (streamBytes + intervalBytes - 1) / intervalBytes);
+    keys_.resize(ranges * keyBytes);
+    std::mt19937_64 gen(seed);
+    for (auto& b : keys_) b = static_cast<uint8_t>(gen());
+}
+
+size_t KeyRotation::rangeOf(uint64_t offset) const {
+    size_t range = static_cast<size_t>(offset / intervalBytes_);
+    if (range >= rangeCount()) {
+        throw std::runtime_error("Stream offset past the end of the key rotation schedule");
+    }
+    return range;
+}
+
+RotatingStream::RotatingStream(ICipherEngine& engine, const KeyRotation& rotation, const uint8_t* iv, bool prefetch)
+    : engine_(engine), rotation_(rotation), algorithm_(engine.getAlgorithmName()), iv_{} {
+    if (!isSeekable(algorithm_)) {
+        throw std::runtime_error("Key rotation needs a seekable stream: " + algorithm_);
+    }
+    if (rotation.intervalBytes() % streamAlignment(algorithm_) != 0) {
+        throw std::runtime_error("Key rotation interval must be a multiple of " +
+                                 std::to_string(streamAlignment(algorithm_)) + " bytes for " + algorithm_);
+    }
+    if (iv) {
+        std::copy_n(iv, iv_.size(), iv_.begin());
+    }
+    if (prefetch) {
+        worker_ = std::thread(&RotatingStream::prefetchLoop, this);
+        requestPrefetch(0, 1);
+    }
+}
+
+RotatingStream::~RotatingStream() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+    }
+}
+
+void RotatingStream::requestPrefetch(uint64_t begin, uint64_t end) {
+    const uint64_t streamEnd = rotation_.rangeCount() * rotation_.intervalBytes();
+    end = std::min(end, streamEnd);
+    if (begin >= end) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nextPrefetch_ = std::max(nextPrefetch_, rotation_.rangeOf(begin));
+        prefetchEnd_ = std::max(prefetchEnd_, rotation_.rangeOf(end - 1) + 1);
+    }
+    wake_.notify_one();
+}
+
+void RotatingStream::prefetchLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stop_ || nextPrefetch_ < prefetchEnd_; });
+        if (stop_) return;
+        size_t range = nextPrefetch_++;
+        lock.unlock();
+        engine_.prepareKey(rotation_.key(range), rotation_.keyBytes());
+        lock.lock();
+    }
+}
+
+void RotatingStream::encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    const uint64_t begin = position_;
+    const uint64_t end = begin + size;
+
+    // Calls are usually the same size, so the next one starts here.
+    if (worker_.joinable()) {
+        requestPrefetch(end, end + size);
+    }
+
+    // Reserved up front: the jobs point into positions_.
+    positions_.clear();
+    jobs_.clear();
+    positions_.reserve(size / rotation_.intervalBytes() + 2);
+    for (uint64_t offset = begin; offset < end;) {
+        size_t range = rotation_.rangeOf(offset);
+        uint64_t rangeEnd = std::min<uint64_t>(end, (range + 1) * rotation_.intervalBytes());
+        if (range != currentRange_) {
+            ++switches_;
+            currentRange_ = range;
+        }
+        positions_.push_back(seekStream(algorithm_, rotation_.key(range), rotation_.keyBytes(), iv_.data(), offset));
+        const StreamPosition& pos = positions_.back();
+        jobs_.push_back(CipherJob{input + (offset - begin), output + (offset - begin), rangeEnd - offset,
+                                  pos.key.data(), rotation_.keyBytes(), pos.iv.data()});
+        offset = rangeEnd;
+    }
+
+    engine_.encryptBatch(jobs_.data(), jobs_.size());
+    position_ = end;
+}
+
+const char* rekeyModeName(RekeyMode mode) {
+    switch (mode) {
+        case RekeyMode::Inline: return "inline";
+        case RekeyMode::Prefetch: return "prefetch";
+    }
+    return "unknown";
+}
+
+KeyRotationResult measureKeyRotation(ICipherEngine& engine, const KeyRotation& rotation, RekeyMode mode,
+                                     const std::vector<uint8_t>& chunk, const uint8_t* iv,
+                                     uint64_t streamBytes, int passes, size_t cacheEntries) {
+    KeyRotationResult result;
+    result.intervalBytes = rotation.intervalBytes();
+    result.streamBytes = streamBytes;
+    result.callBytes = chunk.size();
+
+    const bool prefetch = mode == RekeyMode::Prefetch;
+    CacheCapacityScope capacity(cacheEntries);
+
+    std::vector<uint8_t> output(chunk.size());
+    {
+        RotatingStream warmup(engine, rotation, iv, prefetch);
+        warmup.encrypt(chunk.data(), output.data(), std::min<uint64_t>(chunk.size(), streamBytes));
+    }
+
+    std::vector<double> samples;
+    for (int p = 0; p < std::max(1, passes); ++p) {
+        KeyScheduleCache::shared().clear();
+        RotatingStream stream(engine, rotation, iv, prefetch);
+
+        Clock::time_point start = Clock::now();
+        while (stream.position() < streamBytes) {
+            size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunk.size(), streamBytes - stream.position()));
+            stream.encrypt(chunk.data(), output.data(), bytes);
+        }
+        samples.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+        result.keySwitches = stream.keySwitches();
+    }
+
+    result.throughputMBs = static_cast<double>(streamBytes) / (1024.0 * 1024.0) / computeStats(samples).median;
+    return result;
+}
+
+bool verifyKeyRotation(ICipherEngine& engine, ICipherEngine& reference, const KeyRotation& rotation,
+                       const std::vector<uint8_t>& data, const uint8_t* iv, size_t callBytes) {
+    std::vector<uint8_t> actual(data.size()), expected(data.size());
+    {
+        RotatingStream stream(engine, rotation, iv, false);
+        for (size_t offset = 0; offset < data.size(); offset += callBytes) {
+            size_t bytes = std::min(callBytes, data.size() - offset);
+            stream.encrypt(data.data() + offset, actual.data() + offset, bytes);
+        }
+    }
+
+    const std::string algorithm = reference.getAlgorithmName();
+    for (uint64_t offset = 0; offset < data.size();) {
+        size_t range = rotation.rangeOf(offset);
+        uint64_t end = std::min<uint64_t>(data.size(), (range + 1) * rotation.intervalBytes());
+        StreamPosition pos = seekStream(algorithm, rotation.key(range), rotation.keyBytes(), iv, offset);
+        reference.encrypt(data.data() + offset, expected.data() + offset, end - offset,
+                          pos.key.data(), rotation.keyBytes(), pos.iv.data());
+        offset = end;
+    }
+    return verifyBuffers(expected.data(), actual.data(), data.size());
+}
+
+void writeKeyRotationCsv(const std::vector<KeyRotationResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "Algorithm,Engine,Threads,Variant,Interval_Bytes,Stream_Bytes,Call_Bytes,Key_Switches,"
+         << "Throughput_MBs,Baseline_Fraction,Verified\n";
+    for (const auto& r : results) {
+        file << r.algorithm << "," << r.engine << "," << r.threads << "," << r.variant << ","
+             << r.intervalBytes << "," << r.streamBytes << "," << r.callBytes << "," << r.keySwitches << ","
+             << std::fixed << std::setprecision(2) << r.throughputMBs << ","
+             << std::fixed << std::setprecision(4) << r.baselineFraction << ","
+             << (r.verified ? "PASS" : "FAIL") << "\n";
+    }
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include "stream_position.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Key per byte range of a stream: range i covers
+// [i * intervalBytes, (i + 1) * intervalBytes) and has its own random key.
+// The counter (or block position) runs on across ranges; only the key
+// changes, as under a "rotate every N GB" policy.
+class KeyRotation {
+public:
+    KeyRotation(size_t keyBytes, uint64_t intervalBytes, uint64_t streamBytes, uint64_t seed = 0x7e7a);
+
+    size_t keyBytes() const { return keyBytes_; }
+    uint64_t intervalBytes() const { return intervalBytes_; }
+    size_t rangeCount() const { return keys_.size() / keyBytes_; }
+    size_t rangeOf(uint64_t offset) const;
+    const uint8_t* key(size_t range) const { return keys_.data() + range * keyBytes_; }
+
+private:
+    size_t keyBytes_;
+    uint64_t intervalBytes_;
+    std::vector<uint8_t> keys_;
+};
+
+// Encrypts a seekable stream call by call under a KeyRotation. Each call
+// becomes one encryptBatch() with a job per key range it touches, so the
+// engine switches keys at range boundaries inside its own loop (the OpenMP
+// engines in the middle of one parallel region) instead of returning to
+// the caller for every key. With prefetch, a background thread runs
+// ICipherEngine::prepareKey() for the ranges of the next call while the
+// current one is encrypted, which needs the key schedule cache enabled.
+class RotatingStream {
+public:
+    RotatingStream(ICipherEngine& engine, const KeyRotation& rotation, const uint8_t* iv, bool prefetch);
+    ~RotatingStream();
+
+    RotatingStream(const RotatingStream&) = delete;
+    RotatingStream& operator=(const RotatingStream&) = delete;
+
+    // Next size bytes of the stream.
+    void encrypt(const uint8_t* input, uint8_t* output, size_t size);
+
+    uint64_t position() const { return position_; }
+    size_t keySwitches() const { return switches_; }
+
+private:
+    void requestPrefetch(uint64_t begin, uint64_t end);
+    void prefetchLoop();
+
+    ICipherEngine& engine_;
+    const KeyRotation& rotation_;
+    const std::string algorithm_;
+    std::array<uint8_t, 16> iv_;
+    uint64_t position_ = 0;
+    size_t switches_ = 0;
+    size_t currentRange_ = 0;
+    std::vector<StreamPosition> positions_;
+    std::vector<CipherJob> jobs_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    size_t nextPrefetch_ = 0;  // ranges [nextPrefetch_, prefetchEnd_) still to prepare
+    size_t prefetchEnd_ = 0;
+    bool stop_ = false;
+};
+
+enum class RekeyMode {
+    Inline,   // every switch builds its schedule in the timed call
+    Prefetch  // next call's keys prepared in the background into the cache
+};
+
+const char* rekeyModeName(RekeyMode mode);
+
+struct KeyRotationResult {
+    std::string algorithm;
+    std::string engine;
+    int threads = 1;
+    std::string variant;  // "single-key", "inline" or "prefetch"
+    uint64_t intervalBytes = 0;
+    uint64_t streamBytes = 0;
+    size_t callBytes = 0;
+    size_t keySwitches = 0;  // per stream
+    double throughputMBs = 0;
+    double baselineFraction = 0;  // throughputMBs over the single-key run
+    bool verified = false;
+};
+
+// Encrypts streamBytes of rotation's stream through engine in calls of
+// chunk.size() bytes, passes times, and reports the median throughput.
+// The shared key schedule cache holds cacheEntries for the run and is
+// restored after; pass the same value for every mode and the single-key
+// baseline so they differ only in when keys are expanded. Names, variant
+// and baselineFraction are left to the caller.
+KeyRotationResult measureKeyRotation(ICipherEngine& engine, const KeyRotation& rotation, RekeyMode mode,
+                                     const std::vector<uint8_t>& chunk, const uint8_t* iv,
+                                     uint64_t streamBytes, int passes, size_t cacheEntries);
+
+// Encrypts data through a RotatingStream on engine in calls of callBytes
+// and checks it against reference encrypting each key range on its own.
+bool verifyKeyRotation(ICipherEngine& engine, ICipherEngine& reference, const KeyRotation& rotation,
+                       const std::vector<uint8_t>& data, const uint8_t* iv, size_t callBytes);
+
+void writeKeyRotationCsv(const std::vector<KeyRotationResult>& results, const std::string& path);
+
+}
@@ -0,0 +1,137 @@
+#include "key_schedule_cache.hpp"
+#include <openssl/crypto.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// FNV-1a over kind, a separator, the cipher handle, then the key bytes.
+uint64_t fingerprintOf(const std::string& kind, const EVP_CIPHER* cipher, const uint8_t* key, size_t keyLen) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto mix = [&h](uint8_t b) {
+        h ^= b;
+        h *= 0x100000001b3ULL;
+    };
+    for (char c : kind) mix(static_cast<uint8_t>(c));
+    mix(0);
+    uint8_t handle[sizeof(cipher)];
+    std::memcpy(handle, &cipher, sizeof(cipher));
+    for (uint8_t b : handle) mix(b);
+    for (size_t i = 0; i < keyLen; ++i) mix(key[i]);
+    return h;
+}
+
+}
+
+KeyScheduleCache::Entry::Entry(uint64_t fingerprint, const std::string& kind, const EVP_CIPHER* cipher,
+                               const uint8_t* key, size_t keyLen, std::shared_ptr<const void> value,
+                               double buildSeconds)
+    : fingerprint(fingerprint), kind(kind), cipher(cipher), key(key, key + keyLen), value(std::move(value)),
+      buildSeconds(buildSeconds) {}
+
+KeyScheduleCache::Entry::~Entry() {
+    OPENSSL_cleanse(key.data(), key.size());
+}
+
+KeyScheduleCache& KeyScheduleCache::shared() {
+    static KeyScheduleCache cache;
+    return cache;
+}
+
+void KeyScheduleCache::setCapacity(size_t entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = entries;
+    evictOverCapacity();
+}
+
+size_t KeyScheduleCache::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+KeyScheduleStats KeyScheduleCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    KeyScheduleStats stats = stats_;
+    stats.entries = lru_.size();
+    stats.capacity = capacity_;
+    return stats;
+}
+
+void KeyScheduleCache::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = KeyScheduleStats();
+}
+
+void KeyScheduleCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+}
+
+void KeyScheduleCache::evictOverCapacity() {
+    while (lru_.size() > capacity_) {
+        index_.erase(lru_.back().fingerprint);
+        lru_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
+std::shared_ptr<const void> KeyScheduleCache::lookup(const std::string& kind, const EVP_CIPHER* cipher,
+                                                     const uint8_t* key, size_t keyLen,
+                                                     const std::function<std::shared_ptr<const void>()>& build) {
+    const uint64_t fingerprint = fingerprintOf(kind, cipher, key, keyLen);
+    auto matches = [&](const Entry& e) {
+        return e.kind == kind && e.cipher == cipher && e.key.size() == keyLen &&
+               CRYPTO_memcmp(e.key.data(), key, keyLen) == 0;
+    };
+
+    bool disabled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        disabled = capacity_ == 0;
+        auto it = disabled ? index_.end() : index_.find(fingerprint);
+        if (it != index_.end() && matches(*it->second)) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            ++stats_.hits;
+            stats_.savedSeconds += it->second->buildSeconds;
+            return it->second->value;
+        }
+    }
+    if (disabled) {
+        return build();
+    }
+
+    Clock::time_point start = Clock::now();
+    std::shared_ptr<const void> value = build();
+    double buildSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.misses;
+    stats_.buildSeconds += buildSeconds;
+    if (capacity_ == 0) {
+        return value;
+    }
+
+    auto it = index_.find(fingerprint);
+    if (it != index_.end()) {
+        if (matches(*it->second)) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->value;
+        }
+        // Fingerprint collision: the newer key takes the slot.
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    lru_.emplace_front(fingerprint, kind, cipher, key, keyLen, value, buildSeconds);
+    index_[fingerprint] = lru_.begin();
+    evictOverCapacity();
+    return value;
+}
+
+}
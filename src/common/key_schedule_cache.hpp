@@ -0,0 +1,96 @@
+#pragma once
+
+#include <openssl/evp.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hpc_benchmark {
+
+struct KeyScheduleStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    double buildSeconds = 0;  // spent building entries on misses
+    double savedSeconds = 0;  // build time of the entries hits reused
+    size_t entries = 0;
+    size_t capacity = 0;
+
+    double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0; }
+};
+
+// Bounded LRU of expanded key schedules and keyed cipher contexts, shared
+// by every engine in the process. Entries are found by a 64-bit fingerprint
+// of (kind, cipher, key) and confirmed against the stored key, so a
+// fingerprint collision is a miss, never a wrong schedule. kind names the
+// representation ("EVP AES-256-CTR", "AES-256 words", ...) so engines that
+// expand the same key differently do not share entries; cipher separates
+// contexts keyed through different EVP_CIPHER handles of one kind. Stored
+// keys are compared in constant time and wiped when their entry goes.
+//
+// Disabled (capacity 0) by default: get() then builds every time and
+// nothing is stored or counted.
+class KeyScheduleCache {
+public:
+    static KeyScheduleCache& shared();
+
+    // Shrinking evicts least recently used entries; 0 disables the cache.
+    void setCapacity(size_t entries);
+    size_t getCapacity() const;
+    bool enabled() const { return getCapacity() > 0; }
+
+    // Entry for (kind, key), built with build() on a miss. Building runs
+    // outside the lock; if two threads miss on the same key, the first
+    // insert wins and both return it.
+    template <typename T>
+    std::shared_ptr<const T> get(const std::string& kind, const uint8_t* key, size_t keyLen,
+                                 const std::function<std::shared_ptr<const T>()>& build) {
+        return get<T>(kind, nullptr, key, keyLen, build);
+    }
+
+    // Same for an entry built with a specific cipher handle.
+    template <typename T>
+    std::shared_ptr<const T> get(const std::string& kind, const EVP_CIPHER* cipher, const uint8_t* key,
+                                 size_t keyLen, const std::function<std::shared_ptr<const T>()>& build) {
+        return std::static_pointer_cast<const T>(
+            lookup(kind, cipher, key, keyLen, [&build]() -> std::shared_ptr<const void> { return build(); }));
+    }
+
+    KeyScheduleStats getStats() const;
+    void resetStats();
+    void clear();
+
+private:
+    struct Entry {
+        Entry(uint64_t fingerprint, const std::string& kind, const EVP_CIPHER* cipher, const uint8_t* key,
+              size_t keyLen, std::shared_ptr<const void> value, double buildSeconds);
+        ~Entry();
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+
+        uint64_t fingerprint;
+        std::string kind;
+        const EVP_CIPHER* cipher;
+        std::vector<uint8_t> key;  // wiped by the destructor
+        std::shared_ptr<const void> value;
+        double buildSeconds;
+    };
+
+    std::shared_ptr<const void> lookup(const std::string& kind, const EVP_CIPHER* cipher, const uint8_t* key,
+                                       size_t keyLen, const std::function<std::shared_ptr<const void>()>& build);
+    void evictOverCapacity();
+
+    mutable std::mutex mutex_;
+    size_t capacity_ = 0;
+    std::list<Entry> lru_;  // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+    KeyScheduleStats stats_;
+};
+
+}
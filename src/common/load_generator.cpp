@@ -0,0 +1,214 @@
+#include "load_generator.hpp"
+#include "statistics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct ClientRun {
+    ClientStats stats;
+    std::vector<double> latencies;
+    std::exception_ptr error;
+};
+
+}
+
+size_t PayloadMix::maxSize() const {
+    return sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end());
+}
+
+size_t parseByteSize(const std::string& text) {
+    size_t pos = 0;
+    double value = std::stod(text, &pos);
+    std::string suffix = text.substr(pos);
+    if (suffix == "K" || suffix == "k") value *= 1024;
+    else if (suffix == "M" || suffix == "m") value *= 1024 * 1024;
+    else if (suffix == "G" || suffix == "g") value *= 1024.0 * 1024 * 1024;
+    else if (!suffix.empty()) throw std::runtime_error("Bad byte size: " + text);
+    if (value < 1) throw std::runtime_error("Bad byte size: " + text);
+    return static_cast<size_t>(value);
+}
+
+PayloadMix parsePayloadMix(const std::string& spec) {
+    PayloadMix mix;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        size_t colon = item.find(':');
+        mix.sizes.push_back(parseByteSize(item.substr(0, colon)));
+        mix.weights.push_back(colon == std::string::npos ? 1.0 : std::stod(item.substr(colon + 1)));
+    }
+    if (mix.sizes.empty()) {
+        throw std::runtime_error("Empty payload mix: " + spec);
+    }
+    return mix;
+}
+
+LoadResult runLoad(const std::function<CipherEnginePtr()>& factory, const LoadConfig& config) {
+    const int n = std::max(config.clients, 1);
+    std::vector<ClientRun> runs(n);
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    Clock::time_point start;
+    Clock::time_point deadline;
+
+    LoadResult result;
+    result.config = config;
+
+    auto client = [&](int id) {
+        ClientRun& run = runs[id];
+        run.stats.client = id;
+        CipherEnginePtr engine;
+        std::vector<uint8_t> input, output, key(MAX_KEY_BYTES), iv(16);
+        std::mt19937 gen(0x10ad + id);
+        std::discrete_distribution<size_t> pick(config.payloads.weights.begin(), config.payloads.weights.end());
+
+        try {
+            engine = factory();
+            if (config.engineThreads > 0) engine->setNumThreads(config.engineThreads);
+            engine->initialize();
+            input.resize(config.payloads.maxSize());
+            output.resize(input.size());
+            for (auto& b : input) b = static_cast<uint8_t>(gen());
+            for (auto& b : key) b = static_cast<uint8_t>(gen());
+            for (auto& b : iv) b = static_cast<uint8_t>(gen());
+        } catch (...) {
+            run.error = std::current_exception();
+        }
+
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        if (run.error) return;
+
+        try {
+            auto interval = config.ratePerClient > 0
+                ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.ratePerClient))
+                : Clock::duration::zero();
+            // Stagger open-loop clients so they do not fire in lockstep.
+            Clock::time_point scheduled = start + interval * id / n;
+
+            while (true) {
+                if (config.ratePerClient > 0) {
+                    if (scheduled >= deadline) break;
+                    if (Clock::now() >= deadline) {
+                        run.stats.dropped = static_cast<size_t>((deadline - scheduled + interval - Clock::duration(1)) / interval);
+                        break;
+                    }
+                    std::this_thread::sleep_until(scheduled);
+                } else {
+                    scheduled = Clock::now();
+                    if (scheduled >= deadline) break;
+                }
+
+                size_t size = config.payloads.sizes[pick(gen)];
+                engine->encrypt(input.data(), output.data(), size, key.data(), engine->getKeyBytes(), iv.data());
+                run.latencies.push_back(std::chrono::duration<double>(Clock::now() - scheduled).count());
+                run.stats.requests++;
+                run.stats.bytes += size;
+                scheduled += interval;
+            }
+            engine->cleanup();
+        } catch (...) {
+            run.error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n; ++i) {
+        threads.emplace_back(client, i);
+    }
+    while (ready.load() < n) {
+        std::this_thread::yield();
+    }
+    start = Clock::now();
+    deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.durationSec));
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    result.wallSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (const auto& run : runs) {
+        if (run.error) std::rethrow_exception(run.error);
+    }
+
+    CipherEnginePtr probe = factory();
+    result.algorithm = probe->getAlgorithmName();
+    result.engine = probe->getEngineName();
+
+    std::vector<double> all;
+    size_t totalBytes = 0, totalRequests = 0;
+    double sum = 0, sumSq = 0;
+    for (auto& run : runs) {
+        ClientStats& s = run.stats;
+        s.throughputMBs = s.bytes / (1024.0 * 1024.0) / result.wallSec;
+        s.latencyP50Sec = percentile(run.latencies, 50);
+        s.latencyP95Sec = percentile(run.latencies, 95);
+        s.latencyP99Sec = percentile(run.latencies, 99);
+        s.latencyMaxSec = run.latencies.empty() ? 0 : *std::max_element(run.latencies.begin(), run.latencies.end());
+        all.insert(all.end(), run.latencies.begin(), run.latencies.end());
+        totalBytes += s.bytes;
+        totalRequests += s.requests;
+        result.dropped += s.dropped;
+        sum += s.throughputMBs;
+        sumSq += s.throughputMBs * s.throughputMBs;
+        result.clients.push_back(s);
+    }
+
+    result.aggregateMBs = totalBytes / (1024.0 * 1024.0) / result.wallSec;
+    result.requestsPerSec = totalRequests / result.wallSec;
+    result.fairness = sumSq > 0 ? (sum * sum) / (n * sumSq) : 0;
+    result.latencyP50Sec = percentile(all, 50);
+    result.latencyP95Sec = percentile(all, 95);
+    result.latencyP99Sec = percentile(all, 99);
+    result.latencyMaxSec = all.empty() ? 0 : *std::max_element(all.begin(), all.end());
+    return result;
+}
+
+void writeLoadCsv(const std::vector<LoadResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "Algorithm,Engine,Clients,Mode,Rate_Per_Client,Engine_Threads,Client,Requests,Dropped,Throughput_MBs,"
+         << "Fairness,Latency_P50_Sec,Latency_P95_Sec,Latency_P99_Sec,Latency_Max_Sec\n";
+
+    auto row = [&](const LoadResult& r, const std::string& client, size_t requests, size_t dropped, double mbs,
+                   double p50, double p95, double p99, double max) {
+        file << r.algorithm << "," << r.engine << "," << r.config.clients << ","
+             << (r.config.ratePerClient > 0 ? "open" : "closed") << ","
+             << std::fixed << std::setprecision(2) << r.config.ratePerClient << ","
+             << r.config.engineThreads << "," << client << "," << requests << "," << dropped << ","
+             << std::fixed << std::setprecision(2) << mbs << ","
+             << std::fixed << std::setprecision(4) << r.fairness << ","
+             << std::fixed << std::setprecision(6) << p50 << "," << p95 << "," << p99 << "," << max << "\n";
+    };
+
+    for (const auto& r : results) {
+        size_t requests = 0;
+        for (const auto& c : r.clients) {
+            row(r, std::to_string(c.client), c.requests, c.dropped, c.throughputMBs,
+                c.latencyP50Sec, c.latencyP95Sec, c.latencyP99Sec, c.latencyMaxSec);
+            requests += c.requests;
+        }
+        row(r, "all", requests, r.dropped, r.aggregateMBs, r.latencyP50Sec, r.latencyP95Sec, r.latencyP99Sec, r.latencyMaxSec);
+    }
+}
+
+}
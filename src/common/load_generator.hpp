@@ -0,0 +1,72 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Weighted payload sizes, e.g. "4K:0.7,64K:0.2,1M:0.1" (weights optional).
+struct PayloadMix {
+    std::vector<size_t> sizes;
+    std::vector<double> weights;
+
+    size_t maxSize() const;
+};
+
+PayloadMix parsePayloadMix(const std::string& spec);
+
+// "4096", "64K", "1.5M", "2G".
+size_t parseByteSize(const std::string& text);
+
+struct LoadConfig {
+    int clients = 4;
+    // Requests per second per client; 0 runs closed-loop (back to back).
+    double ratePerClient = 0;
+    double durationSec = 5;
+    int engineThreads = 0;
+    PayloadMix payloads;
+};
+
+struct ClientStats {
+    int client = 0;
+    size_t requests = 0;
+    // Open loop: requests scheduled before the deadline but never sent
+    // because the client was still behind when it passed.
+    size_t dropped = 0;
+    size_t bytes = 0;
+    double throughputMBs = 0;
+    double latencyP50Sec = 0;
+    double latencyP95Sec = 0;
+    double latencyP99Sec = 0;
+    double latencyMaxSec = 0;
+};
+
+struct LoadResult {
+    std::string algorithm;
+    std::string engine;
+    LoadConfig config;
+    double wallSec = 0;
+    double aggregateMBs = 0;
+    double requestsPerSec = 0;
+    size_t dropped = 0;
+    // Jain's index over per-client throughput: 1 = perfectly fair, 1/N = one client starves the rest.
+    double fairness = 0;
+    double latencyP50Sec = 0;
+    double latencyP95Sec = 0;
+    double latencyP99Sec = 0;
+    double latencyMaxSec = 0;
+    std::vector<ClientStats> clients;
+};
+
+// Starts config.clients threads, each with its own engine from `factory`,
+// released together and stopped after config.durationSec. Open-loop
+// latency runs from each request's scheduled start, so queueing behind a
+// slow call is counted rather than hidden; a client that falls behind the
+// rate still stops at the deadline and counts its backlog as dropped.
+LoadResult runLoad(const std::function<CipherEnginePtr()>& factory, const LoadConfig& config);
+
+void writeLoadCsv(const std::vector<LoadResult>& results, const std::string& path);
+
+}
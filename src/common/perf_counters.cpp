@@ -0,0 +1,248 @@
+#include "perf_counters.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+const char* hwEventName(HwEvent event) {
+    static const char* names[HW_EVENT_COUNT] = {
+        "Cycles", "Instructions", "LLC_Misses", "dTLB_Misses", "Branch_Misses"};
+    return names[static_cast<size_t>(event)];
+}
+
+bool HardwareCounters::any() const {
+    for (bool v : valid) {
+        if (v) return true;
+    }
+    return false;
+}
+
+double HardwareCounters::ipc() const {
+    if (!has(HwEvent::Cycles) || !has(HwEvent::Instructions) || get(HwEvent::Cycles) <= 0) {
+        return 0;
+    }
+    return get(HwEvent::Instructions) / get(HwEvent::Cycles);
+}
+
+double HardwareCounters::cyclesPerByte(double bytes) const {
+    if (!has(HwEvent::Cycles) || bytes <= 0) {
+        return 0;
+    }
+    return get(HwEvent::Cycles) / bytes;
+}
+
+double HardwareCounters::bytesPerLlcMiss(double bytes) const {
+    if (!has(HwEvent::LlcMisses) || get(HwEvent::LlcMisses) <= 0) {
+        return 0;
+    }
+    return bytes / get(HwEvent::LlcMisses);
+}
+
+HardwareCounters& HardwareCounters::operator+=(const HardwareCounters& other) {
+    for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+        values[i] += other.values[i];
+        valid[i] = valid[i] || other.valid[i];
+    }
+    return *this;
+}
+
+HardwareCounters& HardwareCounters::operator/=(double divisor) {
+    for (auto& v : values) {
+        v /= divisor;
+    }
+    return *this;
+}
+
+#ifdef __linux__
+namespace {
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+const EventSpec EVENT_SPECS[HW_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                         (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+
+int openEvent(const EventSpec& spec, pid_t tid) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+// The calling thread and the OpenMP workers, starting the pool if it is
+// not running yet. Helper threads such as the power sampler are left out.
+std::vector<pid_t> benchmarkThreads() {
+    std::vector<pid_t> tids{static_cast<pid_t>(syscall(SYS_gettid))};
+#ifdef HAS_OPENMP
+    #pragma omp parallel
+    {
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        #pragma omp critical
+        tids.push_back(tid);
+    }
+#endif
+    std::sort(tids.begin(), tids.end());
+    tids.erase(std::unique(tids.begin(), tids.end()), tids.end());
+    return tids;
+}
+
+}
+#endif
+
+struct PerfCounters::Impl {
+    bool available = false;
+    std::string status = "unsupported platform";
+    std::array<bool, HW_EVENT_COUNT> supported{};
+
+#ifdef __linux__
+    std::map<pid_t, std::array<int, HW_EVENT_COUNT>> fds;
+    bool attached = false;
+
+    void probe() {
+        pid_t self = static_cast<pid_t>(syscall(SYS_gettid));
+        for (size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+            int fd = openEvent(EVENT_SPECS[e], self);
+            if (fd >= 0) {
+                supported[e] = true;
+                available = true;
+                close(fd);
+            } else if (e == 0) {
+                status = std::string("perf_event_open failed: ") + std::strerror(errno);
+            }
+        }
+        if (available) {
+            status = "perf_event_open";
+        } else if (status == "unsupported platform") {
+            status = "no hardware events available";
+        }
+    }
+
+    // Opens counters on the calling thread and the OpenMP workers, once.
+    // Every thread they create afterwards (a larger pool, load clients)
+    // inherits a counter that is read, reset and enabled through its
+    // creator's fd, so attaching it again would count its events twice.
+    // Threads started earlier by anything else, such as the power
+    // monitor's sampler, are not counted.
+    void attachBenchmarkThreads() {
+        if (attached) return;
+        attached = true;
+        for (pid_t tid : benchmarkThreads()) {
+            std::array<int, HW_EVENT_COUNT> threadFds;
+            threadFds.fill(-1);
+            for (size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+                if (supported[e]) {
+                    threadFds[e] = openEvent(EVENT_SPECS[e], tid);
+                }
+            }
+            fds[tid] = threadFds;
+        }
+    }
+
+    void closeAll() {
+        for (auto& entry : fds) {
+            for (int fd : entry.second) {
+                if (fd >= 0) close(fd);
+            }
+        }
+        fds.clear();
+    }
+#endif
+};
+
+PerfCounters::PerfCounters() : impl_(new Impl()) {
+#ifdef __linux__
+    impl_->probe();
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    impl_->closeAll();
+#endif
+    delete impl_;
+}
+
+bool PerfCounters::isAvailable() const {
+    return impl_->available;
+}
+
+std::string PerfCounters::getStatus() const {
+    return impl_->status;
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    if (!impl_->available) return;
+    impl_->attachBenchmarkThreads();
+    for (auto& entry : impl_->fds) {
+        for (int fd : entry.second) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+HardwareCounters PerfCounters::stop() {
+    HardwareCounters counters;
+#ifdef __linux__
+    if (!impl_->available) return counters;
+
+    for (auto& entry : impl_->fds) {
+        for (int fd : entry.second) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (auto& entry : impl_->fds) {
+        for (size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+            int fd = entry.second[e];
+            if (fd < 0) continue;
+
+            uint64_t data[3] = {0, 0, 0};
+            if (read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+
+            double value = static_cast<double>(data[0]);
+            if (data[2] > 0 && data[2] < data[1]) {
+                value *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            }
+            counters.values[e] += value;
+            counters.valid[e] = counters.valid[e] || data[2] > 0;
+        }
+    }
+#endif
+    return counters;
+}
+
+}
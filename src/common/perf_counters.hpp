@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace hpc_benchmark {
+
+enum class HwEvent {
+    Cycles,
+    Instructions,
+    LlcMisses,
+    DtlbMisses,
+    BranchMisses
+};
+
+constexpr size_t HW_EVENT_COUNT = 5;
+
+const char* hwEventName(HwEvent event);
+
+struct HardwareCounters {
+    std::array<double, HW_EVENT_COUNT> values{};
+    std::array<bool, HW_EVENT_COUNT> valid{};
+
+    bool has(HwEvent event) const { return valid[static_cast<size_t>(event)]; }
+    double get(HwEvent event) const { return values[static_cast<size_t>(event)]; }
+    bool any() const;
+
+    double ipc() const;
+    double cyclesPerByte(double bytes) const;
+    double bytesPerLlcMiss(double bytes) const;
+
+    HardwareCounters& operator+=(const HardwareCounters& other);
+    HardwareCounters& operator/=(double divisor);
+};
+
+// Hardware counters via perf_event_open. Counters are attached to the thread
+// calling the first start() and to the OpenMP workers, and inherited by
+// threads those spawn later, so worker activity is summed into one reading
+// while helper threads (the power sampler) stay out of it.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    void start();
+    HardwareCounters stop();
+
+    bool isAvailable() const;
+    std::string getStatus() const;
+
+private:
+    struct Impl;
+    Impl* impl_;
+};
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpc_benchmark {
+
+enum class Phase {
+    Setup,
+    KeySchedule,
+    TransferIn,
+    Compute,
+    TransferOut,
+    Teardown
+};
+
+constexpr size_t PHASE_COUNT = 6;
+
+inline const char* phaseName(Phase phase) {
+    static const char* names[PHASE_COUNT] = {
+        "Setup", "KeySchedule", "TransferIn", "Compute", "TransferOut", "Teardown"};
+    return names[static_cast<size_t>(phase)];
+}
+
+using PhaseClock = std::chrono::steady_clock;
+
+struct PhaseTimings {
+    std::array<double, PHASE_COUNT> seconds{};
+
+    void add(Phase phase, double sec) { seconds[static_cast<size_t>(phase)] += sec; }
+    double get(Phase phase) const { return seconds[static_cast<size_t>(phase)]; }
+    void reset() { seconds.fill(0); }
+
+    double total() const {
+        double sum = 0;
+        for (double s : seconds) sum += s;
+        return sum;
+    }
+
+    PhaseTimings& operator+=(const PhaseTimings& other) {
+        for (size_t i = 0; i < PHASE_COUNT; ++i) seconds[i] += other.seconds[i];
+        return *this;
+    }
+
+    PhaseTimings& operator/=(double divisor) {
+        for (auto& s : seconds) s /= divisor;
+        return *this;
+    }
+};
+
+// Times consecutive phases of one call. Every method is a no-op when no
+// recorder is attached, so engines can leave the scopes in place.
+class PhaseScope {
+public:
+    PhaseScope(PhaseTimings* timings, Phase phase) : timings_(timings), phase_(phase) {
+        if (timings_) start_ = PhaseClock::now();
+    }
+
+    ~PhaseScope() { stop(); }
+
+    void next(Phase phase) {
+        if (!timings_) return;
+        auto now = PhaseClock::now();
+        timings_->add(phase_, std::chrono::duration<double>(now - start_).count());
+        phase_ = phase;
+        start_ = now;
+    }
+
+    void stop() {
+        if (!timings_) return;
+        timings_->add(phase_, std::chrono::duration<double>(PhaseClock::now() - start_).count());
+        timings_ = nullptr;
+    }
+
+private:
+    PhaseTimings* timings_;
+    Phase phase_;
+    PhaseClock::time_point start_;
+};
+
+// Splits a parallel region into thread spin-up (Setup), the work-shared loop
+// (Compute) and the join (Teardown). Each thread calls threadReady() once it
+// can start work; one thread calls workDone() after the loop's barrier.
+class ParallelRegionTimer {
+public:
+    explicit ParallelRegionTimer(PhaseTimings* timings)
+        : timings_(timings), start_(timings ? ticks() : 0), ready_(start_), done_(start_) {}
+
+    void threadReady() {
+        if (!timings_) return;
+        int64_t now = ticks();
+        int64_t prev = ready_.load(std::memory_order_relaxed);
+        while (now > prev && !ready_.compare_exchange_weak(prev, now, std::memory_order_relaxed)) {}
+    }
+
+    void workDone() {
+        if (timings_) done_ = ticks();
+    }
+
+    void finish() {
+        if (!timings_) return;
+        int64_t end = ticks();
+        int64_t ready = ready_.load();
+        timings_->add(Phase::Setup, (ready - start_) / 1e9);
+        timings_->add(Phase::Compute, (done_ - ready) / 1e9);
+        timings_->add(Phase::Teardown, (end - done_) / 1e9);
+        timings_ = nullptr;
+    }
+
+private:
+    static int64_t ticks() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            PhaseClock::now().time_since_epoch()).count();
+    }
+
+    PhaseTimings* timings_;
+    int64_t start_;
+    std::atomic<int64_t> ready_;
+    int64_t done_;
+};
+
+}
@@ -7,6 +7,16 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #ifdef __APPLE__
 #include <mach/mach.h>
@@ -17,44 +27,231 @@
 namespace hpc_benchmark
 {
 
+    namespace
+    {
+#ifdef __linux__
+        // One monotonically increasing sysfs energy counter, kept open so
+        // each sample is a single pread().
+        struct EnergyCounter
+        {
+            std::string name;
+            EnergyDomain domain = EnergyDomain::Package;
+            int fd = -1;
+            uint64_t maxRangeUj = 0;
+            uint64_t last = 0;
+            double totalJoules = 0;
+        };
+
+        bool readCounter(int fd, uint64_t &value)
+        {
+            char buf[32];
+            ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+            if (n <= 0)
+                return false;
+            buf[n] = '\0';
+            value = std::strtoull(buf, nullptr, 10);
+            return true;
+        }
+
+        std::string readLine(const std::string &path)
+        {
+            std::ifstream f(path);
+            std::string line;
+            std::getline(f, line);
+            return line;
+        }
+
+        bool classifyDomain(const std::string &name, EnergyDomain &domain)
+        {
+            if (name.compare(0, 7, "package") == 0)
+                domain = EnergyDomain::Package;
+            else if (name == "core")
+                domain = EnergyDomain::Core;
+            else if (name == "uncore")
+                domain = EnergyDomain::Uncore;
+            else if (name == "dram")
+                domain = EnergyDomain::Dram;
+            else if (name == "psys")
+                domain = EnergyDomain::Psys;
+            else
+                return false;
+            return true;
+        }
+#endif
+    }
+
+    const char *energyDomainName(EnergyDomain domain)
+    {
+        static const char *names[ENERGY_DOMAIN_COUNT] = {"Package", "Core", "Uncore", "DRAM", "Psys"};
+        return names[static_cast<size_t>(domain)];
+    }
+
+    void DomainEnergy::add(EnergyDomain domain, double j)
+    {
+        size_t i = static_cast<size_t>(domain);
+        joules[i] += j;
+        valid[i] = true;
+    }
+
+    DomainEnergy &DomainEnergy::operator+=(const DomainEnergy &other)
+    {
+        for (size_t i = 0; i < ENERGY_DOMAIN_COUNT; ++i)
+        {
+            joules[i] += other.joules[i];
+            valid[i] = valid[i] || other.valid[i];
+        }
+        return *this;
+    }
+
+    DomainEnergy &DomainEnergy::operator/=(double divisor)
+    {
+        for (auto &j : joules)
+            j /= divisor;
+        return *this;
+    }
+
     struct PowerMonitor::Impl
     {
         std::chrono::high_resolution_clock::time_point startTime;
-        double startEnergy = 0;
         std::string source = "none";
         bool available = false;
+        double sampleIntervalSec = 0.1;
 
 #ifdef __linux__
-        std::string raplPath;
+        std::vector<EnergyCounter> counters;
+        std::vector<double> startTotals;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread sampler;
+        bool stopping = false;
+
+        ~Impl()
+        {
+            if (sampler.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                sampler.join();
+            }
+            for (auto &c : counters)
+                close(c.fd);
+        }
+
+        bool addCounter(const std::string &path, uint64_t maxRangeUj, const std::string &name, EnergyDomain domain)
+        {
+            EnergyCounter c;
+            c.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (c.fd < 0)
+                return false;
+            if (!readCounter(c.fd, c.last))
+            {
+                close(c.fd);
+                return false;
+            }
+            c.name = name;
+            c.domain = domain;
+            c.maxRangeUj = maxRangeUj;
+            counters.push_back(c);
+            return true;
+        }
 
-        bool findRaplPath()
+        // Packages are intel-rapl:P, their subdomains intel-rapl:P:M; psys
+        // is another top-level zone. AMD exposes the same powercap layout.
+        bool findRaplDomains()
         {
-            std::vector<std::string> paths = {
-                "/sys/class/powercap/intel-rapl/intel-rapl:0/energy_uj",
-                "/sys/class/powercap/intel-rapl:0/energy_uj",
-                "/sys/devices/virtual/powercap/intel-rapl/intel-rapl:0/energy_uj"};
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            std::vector<fs::path> zones;
+            for (const auto &entry : fs::directory_iterator("/sys/class/powercap", ec))
+            {
+                if (entry.path().filename().string().compare(0, 11, "intel-rapl:") == 0)
+                    zones.push_back(entry.path());
+            }
+            std::sort(zones.begin(), zones.end());
 
-            for (const auto &path : paths)
+            for (const auto &zone : zones)
             {
-                std::ifstream f(path);
-                if (f.good())
+                std::string name = readLine((zone / "name").string());
+                EnergyDomain domain;
+                if (!classifyDomain(name, domain))
+                    continue;
+
+                std::string zoneId = zone.filename().string().substr(11);
+                size_t colon = zoneId.find(':');
+                if (colon != std::string::npos)
                 {
-                    raplPath = path;
-                    return true;
+                    std::string parent = readLine((zone.parent_path() / ("intel-rapl:" + zoneId.substr(0, colon)) / "name").string());
+                    size_t dash = parent.rfind('-');
+                    name += dash == std::string::npos ? "-" + zoneId.substr(0, colon) : parent.substr(dash);
                 }
+
+                // Without the range a wrap cannot be undone; skip the zone.
+                uint64_t maxRange = std::strtoull(readLine((zone / "max_energy_range_uj").string()).c_str(), nullptr, 10);
+                if (maxRange == 0)
+                    continue;
+                addCounter((zone / "energy_uj").string(), maxRange, name, domain);
             }
-            return false;
+            return !counters.empty();
         }
 
-        double readRaplEnergy()
+        // amd_energy hwmon: 64-bit accumulators per socket (and per core,
+        // which the socket counters already include).
+        bool findAmdEnergy()
         {
-            std::ifstream f(raplPath);
-            if (!f)
-                return 0;
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            for (const auto &entry : fs::directory_iterator("/sys/class/hwmon", ec))
+            {
+                if (readLine((entry.path() / "name").string()) != "amd_energy")
+                    continue;
+                for (int i = 1; i < 1024; ++i)
+                {
+                    std::string label = readLine((entry.path() / ("energy" + std::to_string(i) + "_label")).string());
+                    if (label.empty())
+                        break;
+                    if (label.compare(0, 7, "Esocket") == 0)
+                    {
+                        addCounter((entry.path() / ("energy" + std::to_string(i) + "_input")).string(), 0,
+                                   "package-" + label.substr(7), EnergyDomain::Package);
+                    }
+                }
+            }
+            return !counters.empty();
+        }
+
+        void sampleLocked()
+        {
+            for (auto &c : counters)
+            {
+                uint64_t value;
+                if (!readCounter(c.fd, value))
+                    continue;
+                // RAPL counters wrap to 0 after maxRangeUj; the 64-bit
+                // amd_energy ones (maxRangeUj 0) never should, so a step
+                // back there counts as nothing.
+                uint64_t delta;
+                if (value >= c.last)
+                    delta = value - c.last;
+                else if (c.maxRangeUj >= c.last)
+                    delta = (c.maxRangeUj - c.last) + value + 1;
+                else
+                    delta = 0;
+                c.totalJoules += delta / 1e6;
+                c.last = value;
+            }
+        }
 
-            uint64_t microjoules;
-            f >> microjoules;
-            return microjoules / 1e6;
+        void samplerLoop()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto interval = std::chrono::duration<double>(sampleIntervalSec);
+            while (!wake.wait_for(lock, interval, [this] { return stopping; }))
+            {
+                sampleLocked();
+            }
         }
 
         double readNvidiaPower()
@@ -115,10 +312,16 @@ namespace hpc_benchmark
         void detectSource()
         {
 #ifdef __linux__
-            if (findRaplPath())
+            const char *energySource = nullptr;
+            if (findRaplDomains())
+                energySource = "Intel RAPL";
+            else if (findAmdEnergy())
+                energySource = "AMD energy";
+            if (energySource)
             {
-                source = "Intel RAPL";
+                source = energySource;
                 available = true;
+                sampler = std::thread(&Impl::samplerLoop, this);
                 return;
             }
 
@@ -137,8 +340,9 @@ namespace hpc_benchmark
         }
     };
 
-    PowerMonitor::PowerMonitor() : impl_(new Impl())
+    PowerMonitor::PowerMonitor(double sampleIntervalSec) : impl_(new Impl())
     {
+        impl_->sampleIntervalSec = sampleIntervalSec;
         impl_->detectSource();
     }
 
@@ -157,14 +361,28 @@ namespace hpc_benchmark
         return impl_->source;
     }
 
+    std::vector<std::string> PowerMonitor::getDomainNames() const
+    {
+        std::vector<std::string> names;
+#ifdef __linux__
+        for (const auto &c : impl_->counters)
+            names.push_back(c.name);
+#endif
+        return names;
+    }
+
     void PowerMonitor::startMeasurement()
     {
         impl_->startTime = std::chrono::high_resolution_clock::now();
 
 #ifdef __linux__
-        if (impl_->source == "Intel RAPL")
+        if (!impl_->counters.empty())
         {
-            impl_->startEnergy = impl_->readRaplEnergy();
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            impl_->sampleLocked();
+            impl_->startTotals.clear();
+            for (const auto &c : impl_->counters)
+                impl_->startTotals.push_back(c.totalJoules);
         }
 #endif
 
@@ -182,17 +400,19 @@ namespace hpc_benchmark
         reading.source = impl_->source;
 
 #ifdef __linux__
-        if (impl_->source == "Intel RAPL")
+        if (!impl_->counters.empty())
         {
-            double endEnergy = impl_->readRaplEnergy();
-            reading.joules = endEnergy - impl_->startEnergy;
-
-            if (reading.joules < 0)
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            impl_->sampleLocked();
+            for (size_t i = 0; i < impl_->counters.size() && i < impl_->startTotals.size(); ++i)
             {
-                reading.joules += 16777.216;
+                const auto &c = impl_->counters[i];
+                reading.domains.add(c.domain, c.totalJoules - impl_->startTotals[i]);
             }
 
-            reading.watts = reading.joules / reading.durationSec;
+            reading.joules = reading.domains.has(EnergyDomain::Package) ? reading.domains.get(EnergyDomain::Package)
+                                                                        : reading.domains.get(EnergyDomain::Psys);
+            reading.watts = reading.durationSec > 0 ? reading.joules / reading.durationSec : 0;
             reading.valid = true;
         }
         else if (impl_->source == "NVIDIA SMI")
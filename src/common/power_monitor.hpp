@@ -1,31 +1,65 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <cstdint>
+#include <cstddef>
+#include <vector>
 
 namespace hpc_benchmark {
 
+enum class EnergyDomain {
+    Package,
+    Core,
+    Uncore,
+    Dram,
+    Psys
+};
+
+constexpr size_t ENERGY_DOMAIN_COUNT = 5;
+
+const char* energyDomainName(EnergyDomain domain);
+
+// Joules per RAPL domain kind, summed over sockets.
+struct DomainEnergy {
+    std::array<double, ENERGY_DOMAIN_COUNT> joules{};
+    std::array<bool, ENERGY_DOMAIN_COUNT> valid{};
+
+    bool has(EnergyDomain domain) const { return valid[static_cast<size_t>(domain)]; }
+    double get(EnergyDomain domain) const { return joules[static_cast<size_t>(domain)]; }
+    void add(EnergyDomain domain, double j);
+
+    DomainEnergy& operator+=(const DomainEnergy& other);
+    DomainEnergy& operator/=(double divisor);
+};
+
 struct EnergyReading {
     double joules;
     double watts;
     double durationSec;
     bool valid;
     std::string source;
-    
+    DomainEnergy domains;
+
     EnergyReading() : joules(0), watts(0), durationSec(0), valid(false), source("unknown") {}
 };
 
 class PowerMonitor {
 public:
-    PowerMonitor();
+    // RAPL counters are read by a background thread every sampleIntervalSec
+    // so that wraparounds between start and stop are never missed.
+    explicit PowerMonitor(double sampleIntervalSec = 0.1);
     ~PowerMonitor();
-    
+
     void startMeasurement();
     EnergyReading stopMeasurement();
-    
+
     bool isAvailable() const;
     std::string getSource() const;
-    
+
+    // sysfs names of the domains being sampled, e.g. "package-0", "dram-0".
+    std::vector<std::string> getDomainNames() const;
+
 private:
     struct Impl;
     Impl* impl_;
@@ -0,0 +1,249 @@
+#include "result_comparison.hpp"
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+namespace {
+
+struct CsvRow {
+    std::map<std::string, std::string> fields;
+    bool matched = false;
+
+    std::string get(const std::string& column, const std::string& fallback = "") const {
+        auto it = fields.find(column);
+        return it == fields.end() || it->second.empty() ? fallback : it->second;
+    }
+
+    double number(const std::string& column) const {
+        std::string value = get(column);
+        return value.empty() ? 0.0 : std::stod(value);
+    }
+
+    std::string key() const {
+        return get("Platform") + "|" + get("Algorithm") + "|" + get("Engine") + "|" +
+               get("FileSize_MB") + "|" + get("NumThreads") + "|" + get("Affinity", "none");
+    }
+};
+
+std::vector<std::string> splitLine(const std::string& line) {
+    std::vector<std::string> cells;
+    std::stringstream ss(line);
+    std::string cell;
+    while (std::getline(ss, cell, ',')) {
+        cells.push_back(cell);
+    }
+    if (!line.empty() && line.back() == ',') {
+        cells.push_back("");
+    }
+    return cells;
+}
+
+std::vector<CsvRow> readResults(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open results file: " + path);
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        throw std::runtime_error("Empty results file: " + path);
+    }
+    std::vector<std::string> header = splitLine(line);
+
+    std::vector<CsvRow> rows;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> cells = splitLine(line);
+        CsvRow row;
+        for (size_t i = 0; i < header.size() && i < cells.size(); ++i) {
+            row.fields[header[i]] = cells[i];
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+MetricComparison compareThroughput(const CsvRow& base, const CsvRow& cur, double threshold) {
+    MetricComparison m;
+    m.baseline = base.number("Throughput_MBs");
+    m.current = cur.number("Throughput_MBs");
+    if (m.baseline <= 0 || m.current <= 0) return m;
+
+    m.present = true;
+    m.changePercent = (m.current - m.baseline) / m.baseline * 100.0;
+
+    double baseLow = base.number("Time_CI95_Low_Sec");
+    double baseHigh = base.number("Time_CI95_High_Sec");
+    double curLow = cur.number("Time_CI95_Low_Sec");
+    double curHigh = cur.number("Time_CI95_High_Sec");
+    if (baseHigh > 0 && curHigh > 0) {
+        m.significant = curLow > baseHigh || curHigh < baseLow;
+    } else {
+        m.significant = true;
+    }
+
+    if (m.significant && m.changePercent < -threshold) {
+        m.status = ComparisonStatus::Regression;
+    } else if (m.significant && m.changePercent > threshold) {
+        m.status = ComparisonStatus::Improvement;
+    }
+    return m;
+}
+
+MetricComparison compareEnergy(const CsvRow& base, const CsvRow& cur, double threshold) {
+    MetricComparison m;
+    m.baseline = base.number("Energy_Joules");
+    m.current = cur.number("Energy_Joules");
+    if (m.baseline <= 0 || m.current <= 0) return m;
+
+    m.present = true;
+    m.significant = true;
+    m.changePercent = (m.current - m.baseline) / m.baseline * 100.0;
+    if (m.changePercent > threshold) {
+        m.status = ComparisonStatus::Regression;
+    } else if (m.changePercent < -threshold) {
+        m.status = ComparisonStatus::Improvement;
+    }
+    return m;
+}
+
+std::string jsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void writeMetric(std::ostream& out, const char* name, const MetricComparison& m) {
+    out << "\"" << name << "\":";
+    if (!m.present) {
+        out << "null";
+        return;
+    }
+    out << "{\"baseline\":" << m.baseline << ",\"current\":" << m.current
+        << ",\"change_pct\":" << m.changePercent
+        << ",\"significant\":" << (m.significant ? "true" : "false")
+        << ",\"status\":" << jsonString(comparisonStatusName(m.status)) << "}";
+}
+
+}
+
+const char* comparisonStatusName(ComparisonStatus status) {
+    switch (status) {
+        case ComparisonStatus::Improvement: return "improvement";
+        case ComparisonStatus::Regression: return "regression";
+        default: return "unchanged";
+    }
+}
+
+bool RowComparison::regressed() const {
+    return throughput.status == ComparisonStatus::Regression ||
+           energy.status == ComparisonStatus::Regression;
+}
+
+int ComparisonReport::regressions() const {
+    int count = 0;
+    for (const auto& row : rows) {
+        if (row.regressed()) ++count;
+    }
+    return count;
+}
+
+int ComparisonReport::improvements() const {
+    int count = 0;
+    for (const auto& row : rows) {
+        if (!row.regressed() && (row.throughput.status == ComparisonStatus::Improvement ||
+                                 row.energy.status == ComparisonStatus::Improvement)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+ComparisonReport compareResultFiles(const std::string& baselinePath,
+                                    const std::string& currentPath,
+                                    double thresholdPercent) {
+    ComparisonReport report;
+    report.baselinePath = baselinePath;
+    report.currentPath = currentPath;
+    report.thresholdPercent = thresholdPercent;
+
+    std::vector<CsvRow> baseline = readResults(baselinePath);
+    std::vector<CsvRow> current = readResults(currentPath);
+
+    for (auto& cur : current) {
+        std::string key = cur.key();
+        CsvRow* base = nullptr;
+        for (auto& candidate : baseline) {
+            if (!candidate.matched && candidate.key() == key) {
+                base = &candidate;
+                break;
+            }
+        }
+        if (!base) {
+            ++report.unmatchedCurrent;
+            continue;
+        }
+        base->matched = true;
+
+        RowComparison row;
+        row.platform = cur.get("Platform");
+        row.algorithm = cur.get("Algorithm");
+        row.engine = cur.get("Engine");
+        row.affinity = cur.get("Affinity", "none");
+        row.fileSizeMB = std::stoul(cur.get("FileSize_MB", "0"));
+        row.numThreads = std::stoi(cur.get("NumThreads", "0"));
+        row.throughput = compareThroughput(*base, cur, thresholdPercent);
+        row.energy = compareEnergy(*base, cur, thresholdPercent);
+        report.rows.push_back(row);
+    }
+
+    for (const auto& base : baseline) {
+        if (!base.matched) ++report.unmatchedBaseline;
+    }
+    return report;
+}
+
+void writeComparisonJson(const ComparisonReport& report, const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write comparison report: " + path);
+    }
+
+    out << std::setprecision(6);
+    out << "{\"baseline\":" << jsonString(report.baselinePath)
+        << ",\"current\":" << jsonString(report.currentPath)
+        << ",\"threshold_pct\":" << report.thresholdPercent
+        << ",\"matched\":" << report.rows.size()
+        << ",\"unmatched_baseline\":" << report.unmatchedBaseline
+        << ",\"unmatched_current\":" << report.unmatchedCurrent
+        << ",\"regressions\":" << report.regressions()
+        << ",\"improvements\":" << report.improvements()
+        << ",\n\"rows\":[";
+
+    for (size_t i = 0; i < report.rows.size(); ++i) {
+        const RowComparison& row = report.rows[i];
+        out << (i ? ",\n" : "\n")
+            << "{\"platform\":" << jsonString(row.platform)
+            << ",\"algorithm\":" << jsonString(row.algorithm)
+            << ",\"engine\":" << jsonString(row.engine)
+            << ",\"size_mb\":" << row.fileSizeMB
+            << ",\"threads\":" << row.numThreads
+            << ",\"affinity\":" << jsonString(row.affinity)
+            << ",\"regressed\":" << (row.regressed() ? "true" : "false") << ",";
+        writeMetric(out, "throughput", row.throughput);
+        out << ",";
+        writeMetric(out, "energy", row.energy);
+        out << "}";
+    }
+    out << "\n]}\n";
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+enum class ComparisonStatus {
+    Unchanged,
+    Improvement,
+    Regression
+};
+
+const char* comparisonStatusName(ComparisonStatus status);
+
+struct MetricComparison {
+    bool present = false;
+    double baseline = 0;
+    double current = 0;
+    double changePercent = 0;
+    bool significant = false;
+    ComparisonStatus status = ComparisonStatus::Unchanged;
+};
+
+struct RowComparison {
+    std::string platform;
+    std::string algorithm;
+    std::string engine;
+    std::string affinity;
+    size_t fileSizeMB = 0;
+    int numThreads = 0;
+    MetricComparison throughput;
+    MetricComparison energy;
+
+    bool regressed() const;
+};
+
+struct ComparisonReport {
+    std::string baselinePath;
+    std::string currentPath;
+    double thresholdPercent = 0;
+    std::vector<RowComparison> rows;
+    size_t unmatchedBaseline = 0;
+    size_t unmatchedCurrent = 0;
+
+    int regressions() const;
+    int improvements() const;
+};
+
+// Matches rows of two result CSVs by platform, algorithm, engine, size,
+// threads and affinity. Throughput changes beyond the threshold count only
+// when the time CI95 intervals do not overlap (if both files have them);
+// energy changes are judged on the threshold alone.
+ComparisonReport compareResultFiles(const std::string& baselinePath,
+                                    const std::string& currentPath,
+                                    double thresholdPercent);
+
+void writeComparisonJson(const ComparisonReport& report, const std::string& path);
+
+}
@@ -0,0 +1,116 @@
+#include "sector_io.hpp"
+#include "statistics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+}
+
+const char* sectorPatternName(SectorPattern pattern) {
+    switch (pattern) {
+        case SectorPattern::Sequential: return "sequential";
+        case SectorPattern::Random: return "random";
+    }
+    return "unknown";
+}
+
+const char* sectorOpName(SectorOp op) {
+    switch (op) {
+        case SectorOp::Write: return "write";
+        case SectorOp::Read: return "read";
+    }
+    return "unknown";
+}
+
+SectorIoResult runSectorIo(ICipherEngine& engine, const SectorIoConfig& config) {
+    SectorIoResult result;
+    result.algorithm = engine.getAlgorithmName();
+    result.engine = engine.getEngineName();
+    result.config = config;
+
+    const size_t requestBytes = config.sectorBytes * config.sectorsPerRequest;
+    const size_t slots = config.deviceBytes / requestBytes;
+    if (slots == 0) {
+        throw std::runtime_error("Sector I/O device is smaller than one request");
+    }
+
+    std::vector<uint8_t> device(slots * requestBytes), buffer(requestBytes), key(MAX_KEY_BYTES), iv(16, 0);
+    std::mt19937_64 gen(0x5ec7);
+    for (size_t i = 0; i < device.size(); i += 8) {
+        uint64_t v = gen();
+        std::copy_n(reinterpret_cast<const uint8_t*>(&v), std::min<size_t>(8, device.size() - i), device.begin() + i);
+    }
+    for (auto& b : key) b = static_cast<uint8_t>(gen());
+    std::uniform_int_distribution<size_t> pickSlot(0, slots - 1);
+
+    // Writes encrypt the request buffer into the device; reads decrypt the
+    // device into the request buffer.
+    auto issue = [&](size_t slot) {
+        uint64_t sector = static_cast<uint64_t>(slot) * config.sectorsPerRequest;
+        for (int i = 0; i < 8; ++i) iv[i] = static_cast<uint8_t>(sector >> (8 * i));
+        uint8_t* block = device.data() + slot * requestBytes;
+        if (config.op == SectorOp::Write) {
+            engine.encrypt(buffer.data(), block, requestBytes, key.data(), engine.getKeyBytes(), iv.data());
+        } else {
+            engine.decrypt(block, buffer.data(), requestBytes, key.data(), engine.getKeyBytes(), iv.data());
+        }
+    };
+
+    issue(0);
+
+    std::vector<double> latencies;
+    size_t next = 0;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config.minSeconds));
+    Clock::time_point now = start;
+    while (now < deadline || latencies.size() < 3) {
+        size_t slot = config.pattern == SectorPattern::Random ? pickSlot(gen) : next;
+        next = next + 1 == slots ? 0 : next + 1;
+
+        Clock::time_point t0 = Clock::now();
+        issue(slot);
+        now = Clock::now();
+        latencies.push_back(std::chrono::duration<double>(now - t0).count());
+    }
+
+    double elapsed = std::chrono::duration<double>(now - start).count();
+    result.requests = latencies.size();
+    result.iops = result.requests / elapsed;
+    result.throughputMBs = result.iops * requestBytes / (1024.0 * 1024.0);
+    result.latencyP50Sec = percentile(latencies, 50);
+    result.latencyP99Sec = percentile(latencies, 99);
+    result.latencyMaxSec = *std::max_element(latencies.begin(), latencies.end());
+    return result;
+}
+
+void writeSectorIoCsv(const std::vector<SectorIoResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "Algorithm,Engine,Sector_Bytes,Sectors_Per_Request,Request_Bytes,Pattern,Op,Device_Bytes,"
+         << "Requests,Throughput_MBs,IOPS,Latency_P50_Sec,Latency_P99_Sec,Latency_Max_Sec\n";
+    for (const auto& r : results) {
+        const SectorIoConfig& c = r.config;
+        file << r.algorithm << "," << r.engine << "," << c.sectorBytes << "," << c.sectorsPerRequest << ","
+             << c.sectorBytes * c.sectorsPerRequest << "," << sectorPatternName(c.pattern) << ","
+             << sectorOpName(c.op) << "," << c.deviceBytes << "," << r.requests << ","
+             << std::fixed << std::setprecision(2) << r.throughputMBs << ","
+             << std::fixed << std::setprecision(1) << r.iops << ","
+             << std::fixed << std::setprecision(9) << r.latencyP50Sec << "," << r.latencyP99Sec << ","
+             << r.latencyMaxSec << "\n";
+    }
+}
+
+}
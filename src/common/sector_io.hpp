@@ -0,0 +1,52 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+enum class SectorPattern {
+    Sequential,  // requests follow each other through the device
+    Random       // uniformly random request-aligned offsets
+};
+
+enum class SectorOp {
+    Write,  // encrypt
+    Read    // decrypt
+};
+
+const char* sectorPatternName(SectorPattern pattern);
+const char* sectorOpName(SectorOp op);
+
+struct SectorIoConfig {
+    size_t deviceBytes = 64 * 1024 * 1024;
+    size_t sectorBytes = 4096;
+    size_t sectorsPerRequest = 1;
+    SectorPattern pattern = SectorPattern::Random;
+    SectorOp op = SectorOp::Write;
+    double minSeconds = 0.2;
+};
+
+struct SectorIoResult {
+    std::string algorithm;
+    std::string engine;
+    SectorIoConfig config;
+    size_t requests = 0;
+    double throughputMBs = 0;
+    double iops = 0;
+    double latencyP50Sec = 0;
+    double latencyP99Sec = 0;
+    double latencyMaxSec = 0;
+};
+
+// Issues back-to-back requests of sectorsPerRequest sectors against a
+// simulated device of deviceBytes for at least minSeconds. Each request
+// passes its first device sector number as the iv (the XTS tweak), so
+// ciphertext depends on where the request lands, as on a real disk.
+SectorIoResult runSectorIo(ICipherEngine& engine, const SectorIoConfig& config);
+
+void writeSectorIoCsv(const std::vector<SectorIoResult>& results, const std::string& path);
+
+}
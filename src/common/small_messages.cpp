@@ -0,0 +1,78 @@
+#include "small_messages.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+}
+
+SmallMessageResult measureSmallMessages(const BatchSubmit& submit, size_t keyBytes, size_t messageBytes,
+                                        size_t jobsPerCall, double minSeconds, size_t keyCount) {
+    SmallMessageResult result;
+    result.messageBytes = messageBytes;
+    result.jobsPerCall = jobsPerCall;
+    result.keyCount = keyCount;
+
+    // At least 64 KB of messages per timed pass so the clock read stays
+    // negligible, and a whole number of submit() calls.
+    const size_t perPass = std::max<size_t>(jobsPerCall, (64 * 1024 + messageBytes - 1) / messageBytes);
+    const size_t poolJobs = (perPass + jobsPerCall - 1) / jobsPerCall * jobsPerCall;
+
+    std::vector<uint8_t> input(poolJobs * messageBytes), output(poolJobs * messageBytes);
+    std::vector<uint8_t> keys(keyCount * MAX_KEY_BYTES), ivs(poolJobs * 16);
+    std::mt19937 gen(0x5a11);
+    for (auto& b : input) b = static_cast<uint8_t>(gen());
+    for (auto& b : keys) b = static_cast<uint8_t>(gen());
+    for (auto& b : ivs) b = static_cast<uint8_t>(gen());
+
+    std::vector<CipherJob> jobs(poolJobs);
+    for (size_t j = 0; j < poolJobs; ++j) {
+        jobs[j] = CipherJob{input.data() + j * messageBytes, output.data() + j * messageBytes, messageBytes,
+                            keys.data() + (j % keyCount) * MAX_KEY_BYTES, keyBytes, ivs.data() + j * 16};
+    }
+
+    // Warm-up pass also faults in the output pages.
+    for (size_t j = 0; j < poolJobs; j += jobsPerCall) {
+        submit(jobs.data() + j, jobsPerCall);
+    }
+
+    double elapsed = 0;
+    while (elapsed < minSeconds || result.messages < 3 * poolJobs) {
+        Clock::time_point start = Clock::now();
+        for (size_t j = 0; j < poolJobs; j += jobsPerCall) {
+            submit(jobs.data() + j, jobsPerCall);
+        }
+        elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+        result.messages += poolJobs;
+    }
+
+    result.throughputMBs = static_cast<double>(messageBytes) * result.messages / (1024.0 * 1024.0) / elapsed;
+    result.nsPerMessage = elapsed * 1e9 / result.messages;
+    return result;
+}
+
+void writeSmallMessagesCsv(const std::vector<SmallMessageResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    file << "Algorithm,Engine,Submission,Message_Bytes,Jobs_Per_Call,Keys,Messages,Throughput_MBs,"
+         << "Ns_Per_Message,Bulk_Fraction\n";
+    for (const auto& r : results) {
+        file << r.algorithm << "," << r.engine << "," << r.submission << "," << r.messageBytes << ","
+             << r.jobsPerCall << "," << r.keyCount << "," << r.messages << ","
+             << std::fixed << std::setprecision(2) << r.throughputMBs << "," << r.nsPerMessage << ","
+             << std::setprecision(4) << r.bulkFraction << "\n";
+    }
+}
+
+}
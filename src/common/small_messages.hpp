@@ -0,0 +1,36 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Hands count jobs to an engine: one encrypt() per job, or one batch call.
+using BatchSubmit = std::function<void(const CipherJob* jobs, size_t count)>;
+
+struct SmallMessageResult {
+    std::string algorithm;
+    std::string engine;
+    std::string submission;  // "single", "batch" or "bulk"
+    size_t messageBytes = 0;
+    size_t jobsPerCall = 0;
+    size_t keyCount = 1;
+    size_t messages = 0;
+    double throughputMBs = 0;
+    double nsPerMessage = 0;
+    double bulkFraction = 0;  // throughputMBs over the bulk reference
+};
+
+// Encrypts a pool of independent messageBytes messages (a distinct iv each,
+// message j under key j % keyCount) for at least minSeconds, jobsPerCall
+// jobs per submit() call. Fills the measurement fields of the result;
+// names and bulkFraction are left to the caller.
+SmallMessageResult measureSmallMessages(const BatchSubmit& submit, size_t keyBytes, size_t messageBytes,
+                                        size_t jobsPerCall, double minSeconds, size_t keyCount = 1);
+
+void writeSmallMessagesCsv(const std::vector<SmallMessageResult>& results, const std::string& path);
+
+}
@@ -0,0 +1,175 @@
+#include "soak_test.hpp"
+#include "power_monitor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace hpc_benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+SoakWindow summarize(const std::vector<SoakSample>& samples, double fromSec, double toSec) {
+    SoakWindow w;
+    double prev = 0;
+    for (const auto& s : samples) {
+        double dt = s.timeSec - prev;
+        double mid = s.timeSec - dt / 2;
+        prev = s.timeSec;
+        if (mid < fromSec || mid >= toSec) continue;
+        w.samples++;
+        w.seconds += dt;
+        w.throughputMBs += s.throughputMBs * dt;
+        w.watts += s.watts * dt;
+        w.freqAvgMHz += s.freqAvgMHz * dt;
+    }
+    if (w.seconds > 0) {
+        w.throughputMBs /= w.seconds;
+        w.watts /= w.seconds;
+        w.freqAvgMHz /= w.seconds;
+    }
+    return w;
+}
+
+}
+
+std::vector<double> readCpuFrequenciesMHz() {
+    std::vector<double> mhz;
+#ifdef __linux__
+    for (int cpu = 0;; ++cpu) {
+        std::ifstream f("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_cur_freq");
+        double khz;
+        if (!(f >> khz)) break;
+        mhz.push_back(khz / 1000.0);
+    }
+    if (!mhz.empty()) {
+        return mhz;
+    }
+
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 7, "cpu MHz") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                mhz.push_back(std::stod(line.substr(colon + 1)));
+            }
+        }
+    }
+#endif
+    return mhz;
+}
+
+SoakResult runSoak(ICipherEngine& engine, size_t bufferBytes,
+                   double durationSec, double intervalSec, double burstSec) {
+    SoakResult result;
+    result.algorithm = engine.getAlgorithmName();
+    result.engine = engine.getEngineName();
+
+    std::vector<uint8_t> input(bufferBytes), output(bufferBytes), key(MAX_KEY_BYTES), iv(16);
+    std::mt19937 gen(0x50a4);
+    for (auto& b : input) b = static_cast<uint8_t>(gen());
+    for (auto& b : key) b = static_cast<uint8_t>(gen());
+    for (auto& b : iv) b = static_cast<uint8_t>(gen());
+
+    PowerMonitor power;
+    result.powerSource = power.isAvailable() ? power.getSource() : "N/A";
+
+    std::atomic<uint64_t> bytesDone{0};
+    std::atomic<bool> running{true};
+    const Clock::time_point start = Clock::now();
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(intervalSec));
+    const Clock::time_point deadline =
+        start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(durationSec));
+
+    std::thread sampler([&] {
+        Clock::time_point prevTime = start;
+        uint64_t prevBytes = 0;
+        power.startMeasurement();
+
+        for (Clock::time_point tick = start + interval; running.load(); tick += interval) {
+            std::this_thread::sleep_until(std::min(tick, deadline));
+            Clock::time_point now = Clock::now();
+            uint64_t bytes = bytesDone.load();
+            EnergyReading energy = power.stopMeasurement();
+            power.startMeasurement();
+
+            SoakSample s;
+            s.timeSec = std::chrono::duration<double>(now - start).count();
+            double dt = std::chrono::duration<double>(now - prevTime).count();
+            s.throughputMBs = dt > 0 ? (bytes - prevBytes) / (1024.0 * 1024.0) / dt : 0;
+            s.watts = energy.watts;
+            s.joules = energy.joules;
+            s.coreMHz = readCpuFrequenciesMHz();
+            if (!s.coreMHz.empty()) {
+                double sum = 0;
+                for (double f : s.coreMHz) sum += f;
+                s.freqAvgMHz = sum / s.coreMHz.size();
+                s.freqMinMHz = *std::min_element(s.coreMHz.begin(), s.coreMHz.end());
+                s.freqMaxMHz = *std::max_element(s.coreMHz.begin(), s.coreMHz.end());
+            }
+            result.samples.push_back(s);
+
+            prevTime = now;
+            prevBytes = bytes;
+            if (now >= deadline) break;
+        }
+    });
+
+    // Counted per call, so keep calls well under the sample interval.
+    while (Clock::now() < deadline) {
+        engine.encrypt(input.data(), output.data(), bufferBytes, key.data(), engine.getKeyBytes(), iv.data());
+        bytesDone.fetch_add(bufferBytes);
+    }
+    running.store(false);
+    sampler.join();
+
+    result.burst = summarize(result.samples, 0, burstSec);
+    result.steady = summarize(result.samples, burstSec, durationSec * 2);
+    return result;
+}
+
+void writeSoakCsv(const std::vector<SoakResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV file: " + path);
+    }
+
+    size_t cores = 0;
+    for (const auto& r : results) {
+        for (const auto& s : r.samples) cores = std::max(cores, s.coreMHz.size());
+    }
+
+    file << "Algorithm,Engine,Time_Sec,Throughput_MBs,Power_Watts,Energy_Joules,Power_Source,"
+         << "Freq_Avg_MHz,Freq_Min_MHz,Freq_Max_MHz";
+    for (size_t c = 0; c < cores; ++c) {
+        file << ",CPU" << c << "_MHz";
+    }
+    file << "\n";
+
+    for (const auto& r : results) {
+        for (const auto& s : r.samples) {
+            file << r.algorithm << "," << r.engine << ","
+                 << std::fixed << std::setprecision(3) << s.timeSec << ","
+                 << std::fixed << std::setprecision(2) << s.throughputMBs << ","
+                 << std::fixed << std::setprecision(2) << s.watts << ","
+                 << std::fixed << std::setprecision(4) << s.joules << ","
+                 << r.powerSource << ","
+                 << std::fixed << std::setprecision(0) << s.freqAvgMHz << ","
+                 << s.freqMinMHz << "," << s.freqMaxMHz;
+            for (size_t c = 0; c < cores; ++c) {
+                file << ",";
+                if (c < s.coreMHz.size()) file << s.coreMHz[c];
+            }
+            file << "\n";
+        }
+    }
+}
+
+}
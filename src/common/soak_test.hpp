@@ -0,0 +1,49 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Current frequency of every logical CPU in MHz (cpufreq, else
+// /proc/cpuinfo); empty when the platform exposes neither.
+std::vector<double> readCpuFrequenciesMHz();
+
+struct SoakSample {
+    double timeSec = 0;
+    double throughputMBs = 0;
+    double watts = 0;
+    double joules = 0;
+    double freqAvgMHz = 0;
+    double freqMinMHz = 0;
+    double freqMaxMHz = 0;
+    std::vector<double> coreMHz;
+};
+
+struct SoakWindow {
+    size_t samples = 0;
+    double seconds = 0;
+    double throughputMBs = 0;
+    double watts = 0;
+    double freqAvgMHz = 0;
+};
+
+struct SoakResult {
+    std::string algorithm;
+    std::string engine;
+    std::string powerSource;
+    std::vector<SoakSample> samples;
+    SoakWindow burst;
+    SoakWindow steady;
+};
+
+// Encrypts `bufferBytes` back to back for durationSec while a background
+// thread samples throughput, power and per-core frequency every intervalSec.
+// Samples up to burstSec form the burst window, the rest the steady state.
+SoakResult runSoak(ICipherEngine& engine, size_t bufferBytes,
+                   double durationSec, double intervalSec, double burstSec);
+
+void writeSoakCsv(const std::vector<SoakResult>& results, const std::string& path);
+
+}
@@ -0,0 +1,78 @@
+#include "statistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace hpc_benchmark {
+
+double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    double rank = p / 100.0 * (samples.size() - 1);
+    size_t lo = static_cast<size_t>(std::floor(rank));
+    size_t hi = std::min(lo + 1, samples.size() - 1);
+    double frac = rank - lo;
+    return samples[lo] + (samples[hi] - samples[lo]) * frac;
+}
+
+SampleStats computeStats(const std::vector<double>& samples, size_t bootstrapResamples) {
+    SampleStats stats;
+    stats.count = samples.size();
+    if (samples.empty()) {
+        return stats;
+    }
+
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    stats.median = percentile(samples, 50);
+    stats.p95 = percentile(samples, 95);
+    auto mm = std::minmax_element(samples.begin(), samples.end());
+    stats.min = *mm.first;
+    stats.max = *mm.second;
+
+    if (samples.size() > 1) {
+        double sq = 0;
+        for (double s : samples) {
+            sq += (s - stats.mean) * (s - stats.mean);
+        }
+        stats.stddev = std::sqrt(sq / (samples.size() - 1));
+    }
+
+    if (samples.size() < 3 || bootstrapResamples == 0) {
+        stats.ciLow = stats.min;
+        stats.ciHigh = stats.max;
+        return stats;
+    }
+
+    std::mt19937_64 gen(0x5eed);
+    std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+    std::vector<double> resample(samples.size());
+    std::vector<double> medians(bootstrapResamples);
+
+    for (size_t r = 0; r < bootstrapResamples; ++r) {
+        for (auto& v : resample) {
+            v = samples[pick(gen)];
+        }
+        std::nth_element(resample.begin(), resample.begin() + resample.size() / 2, resample.end());
+        double mid = resample[resample.size() / 2];
+        if (resample.size() % 2 == 0) {
+            mid = (mid + *std::max_element(resample.begin(), resample.begin() + resample.size() / 2)) / 2;
+        }
+        medians[r] = mid;
+    }
+
+    stats.ciLow = percentile(medians, 2.5);
+    stats.ciHigh = percentile(medians, 97.5);
+    return stats;
+}
+
+double relativeCIHalfWidth(const SampleStats& stats) {
+    if (stats.median <= 0) {
+        return 0;
+    }
+    return (stats.ciHigh - stats.ciLow) / 2.0 / stats.median;
+}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace hpc_benchmark {
+
+struct SampleStats {
+    size_t count = 0;
+    double mean = 0;
+    double median = 0;
+    double min = 0;
+    double max = 0;
+    double p95 = 0;
+    double stddev = 0;
+    double ciLow = 0;
+    double ciHigh = 0;
+};
+
+double percentile(std::vector<double> samples, double p);
+
+// Percentile-bootstrap 95% confidence interval of the median.
+SampleStats computeStats(const std::vector<double>& samples, size_t bootstrapResamples = 2000);
+
+double relativeCIHalfWidth(const SampleStats& stats);
+
+}
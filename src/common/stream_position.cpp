@@ -0,0 +1,70 @@
+#include "stream_position.hpp"
+#include "kernels/aes_tables.hpp"
+#include "kernels/chacha20.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+bool isCounterMode(const std::string& algorithm) {
+    return algorithm.size() >= 3 && algorithm.compare(algorithm.size() - 3, 3, "CTR") == 0;
+}
+
+bool isCbcMode(const std::string& algorithm) {
+    return algorithm.size() >= 3 && algorithm.compare(algorithm.size() - 3, 3, "CBC") == 0;
+}
+
+bool isSeekable(const std::string& algorithm) {
+    return isCounterMode(algorithm) || algorithm == "XOR" || algorithm == "ChaCha20";
+}
+
+size_t streamAlignment(const std::string& algorithm) {
+    if (algorithm == "ChaCha20") return chacha::BLOCK_BYTES;
+    return isCounterMode(algorithm) ? 16 : 1;
+}
+
+StreamPosition seekStream(const std::string& algorithm,
+                          const uint8_t* key, size_t keyLen,
+                          const uint8_t* iv, uint64_t offset) {
+    StreamPosition pos;
+
+    if (isCounterMode(algorithm)) {
+        if (offset % 16 != 0) {
+            throw std::runtime_error("CTR stream offset must be block aligned");
+        }
+        pos.key.assign(key, key + keyLen);
+        if (iv) {
+            std::memcpy(pos.iv.data(), iv, 16);
+        }
+        aes::addCounter(pos.iv.data(), offset / 16);
+        return pos;
+    }
+
+    if (algorithm == "ChaCha20") {
+        if (offset % chacha::BLOCK_BYTES != 0) {
+            throw std::runtime_error("ChaCha20 stream offset must be block aligned");
+        }
+        pos.key.assign(key, key + keyLen);
+        if (iv) {
+            std::memcpy(pos.iv.data(), iv, 16);
+        }
+        chacha::addCounter(pos.iv.data(), offset / chacha::BLOCK_BYTES);
+        return pos;
+    }
+
+    if (algorithm == "XOR") {
+        pos.key.resize(keyLen);
+        size_t phase = offset % keyLen;
+        for (size_t i = 0; i < keyLen; ++i) {
+            pos.key[i] = key[(phase + i) % keyLen];
+        }
+        if (iv) {
+            std::memcpy(pos.iv.data(), iv, 16);
+        }
+        return pos;
+    }
+
+    throw std::runtime_error("Cannot seek stream for algorithm: " + algorithm);
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Key and IV that make an engine produce the keystream starting at `offset`
+// of the stream defined by the original key/IV.
+struct StreamPosition {
+    std::vector<uint8_t> key;
+    std::array<uint8_t, 16> iv{};
+};
+
+bool isCounterMode(const std::string& algorithm);
+// Chained modes decrypt in parallel but encrypt serially, so the two
+// directions are timed separately.
+bool isCbcMode(const std::string& algorithm);
+// True if seekStream() can position this algorithm's keystream.
+bool isSeekable(const std::string& algorithm);
+size_t streamAlignment(const std::string& algorithm);
+
+StreamPosition seekStream(const std::string& algorithm,
+                          const uint8_t* key, size_t keyLen,
+                          const uint8_t* iv, uint64_t offset);
+
+}
@@ -0,0 +1,196 @@
+#include "tuning_cache.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+std::string hostName() {
+#ifdef __unix__
+    char buf[256] = {};
+    if (gethostname(buf, sizeof(buf) - 1) == 0 && buf[0]) {
+        return buf;
+    }
+#endif
+    return "localhost";
+}
+
+}
+
+OmpSchedule parseOmpSchedule(const std::string& name) {
+    if (name == "static") return OmpSchedule::Static;
+    if (name == "dynamic") return OmpSchedule::Dynamic;
+    if (name == "guided") return OmpSchedule::Guided;
+    throw std::runtime_error("Unknown OpenMP schedule: " + name);
+}
+
+const char* ompScheduleName(OmpSchedule schedule) {
+    switch (schedule) {
+        case OmpSchedule::Static: return "static";
+        case OmpSchedule::Dynamic: return "dynamic";
+        case OmpSchedule::Guided: return "guided";
+    }
+    return "static";
+}
+
+void applyOmpSchedule(OmpSchedule schedule) {
+#ifdef HAS_OPENMP
+    switch (schedule) {
+        case OmpSchedule::Static: omp_set_schedule(omp_sched_static, 0); break;
+        case OmpSchedule::Dynamic: omp_set_schedule(omp_sched_dynamic, 1); break;
+        case OmpSchedule::Guided: omp_set_schedule(omp_sched_guided, 1); break;
+    }
+#else
+    (void)schedule;
+#endif
+}
+
+int sizeClassOf(size_t bytes) {
+    int k = 0;
+    while (k < 63 && (size_t(1) << k) < bytes) {
+        ++k;
+    }
+    return k;
+}
+
+OmpTuning resolveTuning(const std::vector<TuningEntry>& entries, size_t bytes, const OmpTuning& base) {
+    if (entries.empty()) {
+        return base;
+    }
+
+    int target = sizeClassOf(bytes);
+    int bestClass = entries.front().sizeClass;
+    for (const auto& e : entries) {
+        if (std::abs(e.sizeClass - target) < std::abs(bestClass - target)) {
+            bestClass = e.sizeClass;
+        }
+    }
+
+    const TuningEntry* best = nullptr;
+    for (const auto& e : entries) {
+        if (e.sizeClass != bestClass) continue;
+        if (!best) {
+            best = &e;
+        } else if (base.threads > 0) {
+            if (std::abs(e.tuning.threads - base.threads) < std::abs(best->tuning.threads - base.threads)) {
+                best = &e;
+            }
+        } else if (e.throughputMBs > best->throughputMBs) {
+            best = &e;
+        }
+    }
+
+    OmpTuning tuning = best->tuning;
+    if (base.threads > 0) {
+        tuning.threads = base.threads;
+    }
+    return tuning;
+}
+
+TuningCache::TuningCache(const std::string& path) : path_(path) {}
+
+std::string TuningCache::defaultPath() {
+    if (const char* env = std::getenv("HPC_BENCH_TUNING_FILE")) {
+        return env;
+    }
+    std::string file = "tuning-" + hostName() + ".txt";
+    if (const char* home = std::getenv("HOME")) {
+        return std::string(home) + "/.cache/hpc_benchmark/" + file;
+    }
+    return file;
+}
+
+TuningCache& TuningCache::shared() {
+    static TuningCache cache = [] {
+        TuningCache c(defaultPath());
+        c.load();
+        return c;
+    }();
+    return cache;
+}
+
+bool TuningCache::load() {
+    entries_.clear();
+    std::ifstream file(path_);
+    if (!file) {
+        return false;
+    }
+
+    // A bad entry is skipped so a hand-edited file cannot abort startup.
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        TuningEntry e;
+        std::string schedule;
+        if (ss >> e.algorithm >> e.engine >> e.sizeClass >> e.tuning.threads
+               >> schedule >> e.tuning.chunkBytes >> e.throughputMBs) {
+            try {
+                e.tuning.schedule = parseOmpSchedule(schedule);
+            } catch (const std::exception& ex) {
+                std::cerr << "Warning: " << path_ << ":" << lineNumber << ": " << ex.what()
+                          << "; entry skipped\n";
+                continue;
+            }
+            store(e);
+        }
+    }
+    return true;
+}
+
+void TuningCache::save() const {
+    std::filesystem::path path(path_);
+    if (path.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    std::ofstream file(path_);
+    if (!file) {
+        throw std::runtime_error("Cannot write tuning file: " + path_);
+    }
+    file << "# algorithm engine size_class threads schedule chunk_bytes throughput_mbs\n";
+    for (const auto& e : entries_) {
+        file << e.algorithm << " " << e.engine << " " << e.sizeClass << " " << e.tuning.threads << " "
+             << ompScheduleName(e.tuning.schedule) << " " << e.tuning.chunkBytes << " " << e.throughputMBs << "\n";
+    }
+}
+
+void TuningCache::store(const TuningEntry& entry) {
+    for (auto& e : entries_) {
+        if (e.algorithm == entry.algorithm && e.engine == entry.engine &&
+            e.sizeClass == entry.sizeClass && e.tuning.threads == entry.tuning.threads) {
+            e = entry;
+            return;
+        }
+    }
+    entries_.push_back(entry);
+}
+
+std::vector<TuningEntry> TuningCache::entriesFor(const std::string& algorithm, const std::string& engine) const {
+    std::vector<TuningEntry> result;
+    for (const auto& e : entries_) {
+        if (e.algorithm == algorithm && e.engine == engine) {
+            result.push_back(e);
+        }
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+enum class OmpSchedule {
+    Static,
+    Dynamic,
+    Guided
+};
+
+OmpSchedule parseOmpSchedule(const std::string& name);
+const char* ompScheduleName(OmpSchedule schedule);
+
+// Sets the schedule used by `schedule(runtime)` loops on the calling thread.
+void applyOmpSchedule(OmpSchedule schedule);
+
+struct OmpTuning {
+    int threads = 0;
+    OmpSchedule schedule = OmpSchedule::Dynamic;
+    size_t chunkBytes = 1024 * 1024;
+};
+
+// Payloads are bucketed by power of two: class k covers (2^(k-1), 2^k] bytes.
+int sizeClassOf(size_t bytes);
+
+struct TuningEntry {
+    std::string algorithm;
+    std::string engine;
+    int sizeClass = 0;
+    OmpTuning tuning;
+    double throughputMBs = 0;
+};
+
+// Picks the tuned schedule and chunk size for a payload from the entries of
+// one engine: nearest size class, then the entry measured at the nearest
+// thread count (or the fastest one when base.threads is 0). Returns base
+// unchanged when nothing has been tuned.
+OmpTuning resolveTuning(const std::vector<TuningEntry>& entries, size_t bytes, const OmpTuning& base);
+
+// Per-host store of autotuner winners, one entry per engine, size class and
+// thread count. Stored as whitespace-separated text so it can be edited.
+class TuningCache {
+public:
+    explicit TuningCache(const std::string& path);
+
+    // $HPC_BENCH_TUNING_FILE, else ~/.cache/hpc_benchmark/tuning-<hostname>.txt
+    static std::string defaultPath();
+
+    // Process-wide cache, loaded from defaultPath() on first use.
+    static TuningCache& shared();
+
+    const std::string& getPath() const { return path_; }
+    void setPath(const std::string& path) { path_ = path; }
+
+    bool load();
+    void save() const;
+
+    void store(const TuningEntry& entry);
+    std::vector<TuningEntry> entriesFor(const std::string& algorithm, const std::string& engine) const;
+    const std::vector<TuningEntry>& getEntries() const { return entries_; }
+
+private:
+    std::string path_;
+    std::vector<TuningEntry> entries_;
+};
+
+}
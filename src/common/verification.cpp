@@ -1,5 +1,9 @@
 #include "verification.hpp"
+#include "stream_position.hpp"
 #include <openssl/evp.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -168,4 +172,37 @@ bool verifyFiles(const std::string& original, const std::string& decrypted) {
     }
 }
 
+bool verifySampledWindows(ICipherEngine& reference,
+                          const uint8_t* plaintext, const uint8_t* ciphertext, size_t size,
+                          const uint8_t* key, size_t keyLen, const uint8_t* iv,
+                          size_t numSamples, size_t windowSize) {
+    if (size == 0) {
+        return true;
+    }
+
+    const std::string algorithm = reference.getAlgorithmName();
+    const size_t align = streamAlignment(algorithm);
+    windowSize = std::min(windowSize, size);
+
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::uniform_int_distribution<size_t> dis(0, (size - windowSize) / align);
+
+    std::vector<uint8_t> expected(windowSize);
+
+    for (size_t s = 0; s < numSamples; ++s) {
+        size_t offset = dis(gen) * align;
+        size_t len = std::min(windowSize, size - offset);
+
+        StreamPosition pos = seekStream(algorithm, key, keyLen, iv, offset);
+        reference.encrypt(plaintext + offset, expected.data(), len,
+                          pos.key.data(), pos.key.size(), pos.iv.data());
+
+        if (std::memcmp(expected.data(), ciphertext + offset, len) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }
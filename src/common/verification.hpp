@@ -1,5 +1,6 @@
 #pragma once
 
+#include "engines/i_cipher_engine.hpp"
 #include <string>
 #include <cstdint>
 #include <cstddef>
@@ -16,4 +17,9 @@ std::string calculateSHA256File(const std::string& filename);
 bool verifyBuffers(const uint8_t* original, const uint8_t* decrypted, size_t size);
 bool verifyFiles(const std::string& original, const std::string& decrypted);
 
+bool verifySampledWindows(ICipherEngine& reference,
+                          const uint8_t* plaintext, const uint8_t* ciphertext, size_t size,
+                          const uint8_t* key, size_t keyLen, const uint8_t* iv,
+                          size_t numSamples, size_t windowSize = 4096);
+
 }
@@ -0,0 +1,215 @@
+#include "aes_cbc.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <cstring>
+#include <vector>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+constexpr size_t CBC_BLOCK_BYTES = 16;
+
+void checkJob(size_t size, size_t keyLen) {
+    if (keyLen != AesCbcEngine::KEY_BYTES) {
+        throw std::runtime_error("AES-256-CBC requires 32-byte key");
+    }
+    if (size % CBC_BLOCK_BYTES != 0) {
+        throw std::runtime_error("AES-256-CBC input must be a multiple of 16 bytes");
+    }
+}
+
+// Runs one CBC stream on ctx. key == nullptr keeps the schedule already in
+// ctx and only resets the chaining value.
+bool cbcUpdate(EVP_CIPHER_CTX* ctx, bool encrypting, const uint8_t* key, const uint8_t* iv,
+               const uint8_t* input, uint8_t* output, size_t size) {
+    int outLen = 0;
+    if (key) {
+        if (EVP_CipherInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key, iv, encrypting ? 1 : 0) != 1) {
+            return false;
+        }
+        EVP_CIPHER_CTX_set_padding(ctx, 0);
+    } else if (EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv, -1) != 1) {
+        return false;
+    }
+    return size == 0 || EVP_CipherUpdate(ctx, output, &outLen, input, static_cast<int>(size)) == 1;
+}
+
+}
+
+struct AesCbcEngine::Impl {
+    EVP_CIPHER_CTX* ctx = nullptr;
+    std::array<uint8_t, 16> defaultIV;
+    
+    Impl() {
+        ctx = EVP_CIPHER_CTX_new();
+        RAND_bytes(defaultIV.data(), 16);
+    }
+    
+    ~Impl() {
+        if (ctx) EVP_CIPHER_CTX_free(ctx);
+    }
+};
+
+AesCbcEngine::AesCbcEngine(bool parallel) : impl_(new Impl()), parallel_(parallel) {}
+
+AesCbcEngine::~AesCbcEngine() {
+    delete impl_;
+}
+
+bool AesCbcEngine::isAvailable() const {
+#ifdef HAS_OPENMP
+    return true;
+#else
+    return !parallel_;
+#endif
+}
+
+void AesCbcEngine::encrypt(const uint8_t* input, uint8_t* output,
+                           size_t size, const uint8_t* key, size_t keyLen,
+                           const uint8_t* iv) {
+    checkJob(size, keyLen);
+    
+    PhaseScope phase(phases_, Phase::Compute);
+    if (!cbcUpdate(impl_->ctx, true, key, iv ? iv : impl_->defaultIV.data(), input, output, size)) {
+        throw std::runtime_error("AES-256-CBC encryption failed");
+    }
+}
+
+void AesCbcEngine::decrypt(const uint8_t* input, uint8_t* output,
+                           size_t size, const uint8_t* key, size_t keyLen,
+                           const uint8_t* iv) {
+    checkJob(size, keyLen);
+    const uint8_t* actualIV = iv ? iv : impl_->defaultIV.data();
+    const size_t blocks = size / CBC_BLOCK_BYTES;
+    
+    size_t ranges = 1;
+#ifdef HAS_OPENMP
+    if (parallel_) {
+        if (numThreads_ > 0) {
+            omp_set_num_threads(numThreads_);
+        }
+        ranges = std::min<size_t>(static_cast<size_t>(omp_get_max_threads()), blocks);
+    }
+#endif
+    
+    if (ranges <= 1) {
+        PhaseScope phase(phases_, Phase::Compute);
+        if (!cbcUpdate(impl_->ctx, false, key, actualIV, input, output, size)) {
+            throw std::runtime_error("AES-256-CBC decryption failed");
+        }
+        return;
+    }
+    
+    // Range r starts at block first[r] and chains from the ciphertext block
+    // before it. Those blocks are copied up front because an in-place call
+    // overwrites them while the previous range is decrypted.
+    std::vector<size_t> first(ranges + 1);
+    std::vector<uint8_t> chain(ranges * CBC_BLOCK_BYTES);
+    for (size_t r = 0; r <= ranges; ++r) {
+        first[r] = blocks * r / ranges;
+    }
+    std::memcpy(chain.data(), actualIV, CBC_BLOCK_BYTES);
+    for (size_t r = 1; r < ranges; ++r) {
+        std::memcpy(chain.data() + r * CBC_BLOCK_BYTES, input + (first[r] - 1) * CBC_BLOCK_BYTES, CBC_BLOCK_BYTES);
+    }
+    
+    std::atomic<bool> failed{false};
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel
+    {
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        region.threadReady();
+        
+        #pragma omp for schedule(static)
+        for (size_t r = 0; r < ranges; ++r) {
+            size_t offset = first[r] * CBC_BLOCK_BYTES;
+            size_t bytes = (first[r + 1] - first[r]) * CBC_BLOCK_BYTES;
+            if (!cbcUpdate(ctx, false, key, chain.data() + r * CBC_BLOCK_BYTES,
+                           input + offset, output + offset, bytes)) {
+                failed = true;
+            }
+        }
+        
+        #pragma omp master
+        region.workDone();
+        
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    region.finish();
+    
+    if (failed) {
+        throw std::runtime_error("AES-256-CBC decryption failed");
+    }
+}
+
+void AesCbcEngine::encryptBatch(const CipherJob* jobs, size_t count) {
+    for (size_t j = 0; j < count; ++j) {
+        checkJob(jobs[j].size, jobs[j].keyLen);
+    }
+    
+    if (!parallel_) {
+        PhaseScope phase(phases_, Phase::Compute);
+        const uint8_t* scheduledKey = nullptr;
+        for (size_t j = 0; j < count; ++j) {
+            const CipherJob& job = jobs[j];
+            const uint8_t* iv = job.iv ? job.iv : impl_->defaultIV.data();
+            if (!cbcUpdate(impl_->ctx, true, job.key == scheduledKey ? nullptr : job.key, iv,
+                           job.input, job.output, job.size)) {
+                throw std::runtime_error("AES-256-CBC encryption failed");
+            }
+            scheduledKey = job.key;
+        }
+        return;
+    }
+    
+#ifdef HAS_OPENMP
+    if (numThreads_ > 0) {
+        omp_set_num_threads(numThreads_);
+    }
+#endif
+    
+    std::atomic<bool> failed{false};
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel
+    {
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        const uint8_t* scheduledKey = nullptr;
+        region.threadReady();
+        
+        #pragma omp for schedule(dynamic)
+        for (size_t j = 0; j < count; ++j) {
+            const CipherJob& job = jobs[j];
+            const uint8_t* iv = job.iv ? job.iv : impl_->defaultIV.data();
+            if (!cbcUpdate(ctx, true, job.key == scheduledKey ? nullptr : job.key, iv,
+                           job.input, job.output, job.size)) {
+                failed = true;
+            }
+            scheduledKey = job.key;
+        }
+        
+        #pragma omp master
+        region.workDone();
+        
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    region.finish();
+    
+    if (failed) {
+        throw std::runtime_error("AES-256-CBC encryption failed");
+    }
+}
+
+}
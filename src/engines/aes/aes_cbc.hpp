@@ -0,0 +1,49 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+
+namespace hpc_benchmark {
+
+// AES-256-CBC without padding: sizes must be a multiple of 16. Encryption
+// chains every block through the previous ciphertext block and cannot be
+// split, so the parallel variant encrypts one message on the calling
+// thread and only spreads independent messages (encryptBatch) across
+// threads. Decryption only needs the previous ciphertext block, which is
+// already known, so it splits the message into one contiguous range per
+// thread, each starting from the ciphertext block before it.
+class AesCbcEngine : public ICipherEngine {
+public:
+    static constexpr size_t KEY_BYTES = 32;
+    
+    // parallel = false runs decryption and batches on the calling thread.
+    explicit AesCbcEngine(bool parallel = true);
+    ~AesCbcEngine() override;
+    
+    std::string getAlgorithmName() const override { return "AES-256-CBC"; }
+    std::string getEngineName() const override { return parallel_ ? "OpenMP" : "Sequential"; }
+    
+    void encrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    void decrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    // Each job is its own CBC stream; the parallel variant hands whole
+    // jobs to threads.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
+    bool isAvailable() const override;
+    
+    void setNumThreads(int threads) override { numThreads_ = threads; }
+    size_t getKeyBytes() const override { return KEY_BYTES; }
+
+private:
+    struct Impl;
+    Impl* impl_;
+    bool parallel_;
+    int numThreads_ = 0;
+};
+
+}
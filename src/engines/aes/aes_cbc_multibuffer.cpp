@@ -0,0 +1,124 @@
+#include "aes_cbc_multibuffer.hpp"
+#include "kernels/aes_multibuffer.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+#include <cstring>
+#include <array>
+#include <vector>
+
+namespace hpc_benchmark {
+
+namespace {
+
+constexpr int CBC_ROUNDS = 14;
+
+void checkJob(size_t size, size_t keyLen) {
+    if (keyLen != AesCbcMultiBufferEngine::KEY_BYTES) {
+        throw std::runtime_error("AES-256-CBC requires 32-byte key");
+    }
+    if (size % 16 != 0) {
+        throw std::runtime_error("AES-256-CBC input must be a multiple of 16 bytes");
+    }
+}
+
+}
+
+struct AesCbcMultiBufferEngine::Impl {
+    static constexpr size_t SCHEDULE_BYTES = (CBC_ROUNDS + 1) * 16;
+    
+    bool useKernel;
+    EVP_CIPHER_CTX* ctx = nullptr;
+    std::array<uint8_t, 16> defaultIV;
+    
+    // Scratch reused across batches: one schedule per distinct key run.
+    std::vector<uint8_t> schedules;
+    std::vector<aes::CbcJob> cbcJobs;
+    
+    Impl() : useKernel(aes::multiBufferSupported()) {
+        ctx = EVP_CIPHER_CTX_new();
+        RAND_bytes(defaultIV.data(), 16);
+    }
+    
+    ~Impl() {
+        if (ctx) EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    void evp(bool encrypting, const CipherJob& job) {
+        int outLen = 0;
+        const uint8_t* iv = job.iv ? job.iv : defaultIV.data();
+        if (EVP_CipherInit_ex(ctx, EVP_aes_256_cbc(), nullptr, job.key, iv, encrypting ? 1 : 0) != 1 ||
+            EVP_CIPHER_CTX_set_padding(ctx, 0) != 1 ||
+            (job.size > 0 && EVP_CipherUpdate(ctx, job.output, &outLen, job.input, static_cast<int>(job.size)) != 1)) {
+            throw std::runtime_error(encrypting ? "AES-256-CBC encryption failed"
+                                                : "AES-256-CBC decryption failed");
+        }
+    }
+};
+
+AesCbcMultiBufferEngine::AesCbcMultiBufferEngine() : impl_(new Impl()) {}
+
+AesCbcMultiBufferEngine::~AesCbcMultiBufferEngine() {
+    delete impl_;
+}
+
+void AesCbcMultiBufferEngine::encrypt(const uint8_t* input, uint8_t* output,
+                                      size_t size, const uint8_t* key, size_t keyLen,
+                                      const uint8_t* iv) {
+    CipherJob job{input, output, size, key, keyLen, iv};
+    encryptBatch(&job, 1);
+}
+
+void AesCbcMultiBufferEngine::decrypt(const uint8_t* input, uint8_t* output,
+                                      size_t size, const uint8_t* key, size_t keyLen,
+                                      const uint8_t* iv) {
+    checkJob(size, keyLen);
+    PhaseScope phase(phases_, Phase::Compute);
+    impl_->evp(false, CipherJob{input, output, size, key, keyLen, iv});
+}
+
+void AesCbcMultiBufferEngine::encryptBatch(const CipherJob* jobs, size_t count) {
+    for (size_t j = 0; j < count; ++j) {
+        checkJob(jobs[j].size, jobs[j].keyLen);
+    }
+    
+    PhaseScope phase(phases_, Phase::Setup);
+    
+    if (!impl_->useKernel) {
+        phase.next(Phase::Compute);
+        for (size_t j = 0; j < count; ++j) {
+            impl_->evp(true, jobs[j]);
+        }
+        return;
+    }
+    
+    // Size the schedule store for the worst case first, so pointers into it
+    // stay valid while the job list is built.
+    const size_t scheduleBytes = Impl::SCHEDULE_BYTES;
+    if (impl_->schedules.size() < count * scheduleBytes) {
+        impl_->schedules.resize(count * scheduleBytes);
+    }
+    impl_->cbcJobs.resize(count);
+    
+    phase.next(Phase::KeySchedule);
+    const uint8_t* previousKey = nullptr;
+    const uint8_t* schedule = nullptr;
+    size_t used = 0;
+    for (size_t j = 0; j < count; ++j) {
+        const CipherJob& job = jobs[j];
+        if (!previousKey || (job.key != previousKey && std::memcmp(job.key, previousKey, KEY_BYTES) != 0)) {
+            uint8_t* expanded = impl_->schedules.data() + used * scheduleBytes;
+            aes::roundKeyBytes<256>(job.key, expanded);
+            schedule = expanded;
+            previousKey = job.key;
+            ++used;
+        }
+        impl_->cbcJobs[j] = aes::CbcJob{schedule, job.iv ? job.iv : impl_->defaultIV.data(),
+                                        job.input, job.output, job.size};
+    }
+    
+    phase.next(Phase::Compute);
+    aes::cbcEncryptMultiBuffer(impl_->cbcJobs.data(), count, CBC_ROUNDS);
+}
+
+}
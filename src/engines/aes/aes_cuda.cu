@@ -1,8 +1,9 @@
 #include "aes_cuda.cuh"
-#include "kernels/aes_tables.hpp"
+#include "engines/aes/aes_key_size.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
+#include <vector>
 
 #ifdef HAS_CUDA
 #include <cuda_runtime.h>
@@ -75,18 +76,23 @@ __device__ void d_aes_final_round(uint8_t* state, const uint8_t* roundKey) {
     for (int i = 0; i < 16; i++) state[i] = tmp[i] ^ roundKey[i];
 }
 
-__device__ void d_aes256_encrypt_block(uint8_t* block, const uint32_t* roundKeys) {
+// Rounds is 10, 12 or 14 (AES-128/192/256); the schedule holds
+// 4 * (Rounds + 1) words.
+template <int Rounds>
+__device__ void d_aes_encrypt_block(uint8_t* block, const uint32_t* roundKeys) {
     const uint8_t* rk = reinterpret_cast<const uint8_t*>(roundKeys);
     
     for (int i = 0; i < 16; i++) block[i] ^= rk[i];
     
-    for (int round = 1; round < 14; round++) {
+    #pragma unroll
+    for (int round = 1; round < Rounds; round++) {
         d_aes_round(block, rk + round * 16);
     }
     
-    d_aes_final_round(block, rk + 14 * 16);
+    d_aes_final_round(block, rk + Rounds * 16);
 }
 
+template <int Rounds>
 __global__ void aesCtrEncryptKernel(const uint8_t* input, uint8_t* output,
                                      const uint32_t* roundKeys, const uint8_t* iv,
                                      size_t numBlocks) {
@@ -103,7 +109,50 @@ __global__ void aesCtrEncryptKernel(const uint8_t* input, uint8_t* output,
         ctr = (ctr >> 8) + (sum >> 8);
     }
     
-    d_aes256_encrypt_block(counter, roundKeys);
+    d_aes_encrypt_block<Rounds>(counter, roundKeys);
+    
+    size_t offset = idx * 16;
+    for (int i = 0; i < 16; i++) {
+        output[offset + i] = input[offset + i] ^ counter[i];
+    }
+}
+
+// One job of a packed batch: its blocks start at firstBlock of the device
+// buffer and use schedule keyIndex of the round-key table.
+struct CudaBatchJob {
+    uint64_t firstBlock;
+    uint32_t keyIndex;
+    uint32_t reserved;
+    uint8_t iv[16];
+};
+
+template <int Rounds>
+__global__ void aesCtrBatchKernel(const uint8_t* input, uint8_t* output,
+                                  const uint32_t* roundKeys, const CudaBatchJob* jobs,
+                                  size_t numJobs, size_t numBlocks) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= numBlocks) return;
+    
+    // Jobs are in firstBlock order; take the last one starting at or before idx.
+    size_t lo = 0, hi = numJobs;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (jobs[mid].firstBlock <= idx) lo = mid;
+        else hi = mid;
+    }
+    const CudaBatchJob& job = jobs[lo];
+    
+    uint8_t counter[16];
+    for (int i = 0; i < 16; i++) counter[i] = job.iv[i];
+    
+    uint64_t ctr = idx - job.firstBlock;
+    for (int i = 15; i >= 8 && ctr > 0; i--) {
+        uint64_t sum = counter[i] + (ctr & 0xFF);
+        counter[i] = static_cast<uint8_t>(sum & 0xFF);
+        ctr = (ctr >> 8) + (sum >> 8);
+    }
+    
+    d_aes_encrypt_block<Rounds>(counter, roundKeys + job.keyIndex * 4 * (Rounds + 1));
     
     size_t offset = idx * 16;
     for (int i = 0; i < 16; i++) {
@@ -114,17 +163,21 @@ __global__ void aesCtrEncryptKernel(const uint8_t* input, uint8_t* output,
 
 namespace hpc_benchmark {
 
-AesCudaEngine::AesCudaEngine() 
+template <int KeyBits>
+AesCudaEngine<KeyBits>::AesCudaEngine() 
     : d_input_(nullptr), d_output_(nullptr), d_roundKeys_(nullptr), d_iv_(nullptr),
-      allocatedSize_(0), initialized_(false) {
+      allocatedSize_(0), d_batchJobs_(nullptr), batchJobsCapacity_(0),
+      d_batchKeys_(nullptr), batchKeysCapacity_(0), initialized_(false) {
     for (int i = 0; i < 16; i++) defaultIV_[i] = static_cast<uint8_t>(i);
 }
 
-AesCudaEngine::~AesCudaEngine() {
+template <int KeyBits>
+AesCudaEngine<KeyBits>::~AesCudaEngine() {
     cleanup();
 }
 
-bool AesCudaEngine::isAvailable() const {
+template <int KeyBits>
+bool AesCudaEngine<KeyBits>::isAvailable() const {
 #ifdef HAS_CUDA
     int deviceCount = 0;
     cudaError_t err = cudaGetDeviceCount(&deviceCount);
@@ -134,7 +187,8 @@ bool AesCudaEngine::isAvailable() const {
 #endif
 }
 
-void AesCudaEngine::initialize() {
+template <int KeyBits>
+void AesCudaEngine<KeyBits>::initialize() {
 #ifdef HAS_CUDA
     if (initialized_) return;
     
@@ -143,36 +197,44 @@ void AesCudaEngine::initialize() {
     if (deviceCount == 0) throw std::runtime_error("No CUDA devices");
     
     CUDA_CHECK(cudaSetDevice(0));
-    CUDA_CHECK(cudaMalloc(&d_roundKeys_, 60 * sizeof(uint32_t)));
+    CUDA_CHECK(cudaMalloc(&d_roundKeys_, sizeof(RoundKeyWords)));
     CUDA_CHECK(cudaMalloc(&d_iv_, 16));
     
     initialized_ = true;
 #endif
 }
 
-void AesCudaEngine::cleanup() {
+template <int KeyBits>
+void AesCudaEngine<KeyBits>::cleanup() {
 #ifdef HAS_CUDA
     if (d_input_) { cudaFree(d_input_); d_input_ = nullptr; }
     if (d_output_) { cudaFree(d_output_); d_output_ = nullptr; }
     if (d_roundKeys_) { cudaFree(d_roundKeys_); d_roundKeys_ = nullptr; }
     if (d_iv_) { cudaFree(d_iv_); d_iv_ = nullptr; }
+    if (d_batchJobs_) { cudaFree(d_batchJobs_); d_batchJobs_ = nullptr; }
+    if (d_batchKeys_) { cudaFree(d_batchKeys_); d_batchKeys_ = nullptr; }
+    uploadedKeys_.reset();
     allocatedSize_ = 0;
+    batchJobsCapacity_ = 0;
+    batchKeysCapacity_ = 0;
     initialized_ = false;
 #endif
 }
 
-void AesCudaEngine::encrypt(const uint8_t* input, uint8_t* output, 
-                             size_t size, const uint8_t* key, size_t keyLen,
-                             const uint8_t* iv) {
+template <int KeyBits>
+void AesCudaEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                      size_t size, const uint8_t* key, size_t keyLen,
+                                      const uint8_t* iv) {
 #ifdef HAS_CUDA
-    if (keyLen != 32) throw std::runtime_error("AES-256 requires 32-byte key");
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
     if (!initialized_) initialize();
     
     const uint8_t* actualIV = iv ? iv : defaultIV_.data();
     
-    uint32_t roundKeys[60];
-    aes::keyExpansion256(key, roundKeys);
+    PhaseScope phase(phases_, Phase::KeySchedule);
+    std::shared_ptr<const RoundKeyWords> roundKeys = AesKeyTraits<KeyBits>::roundKeyWords(key);
     
+    phase.next(Phase::Setup);
     size_t paddedSize = ((size + 15) / 16) * 16;
     size_t numBlocks = paddedSize / 16;
     
@@ -184,32 +246,123 @@ void AesCudaEngine::encrypt(const uint8_t* input, uint8_t* output,
         allocatedSize_ = paddedSize;
     }
     
+    phase.next(Phase::TransferIn);
     CUDA_CHECK(cudaMemcpy(d_input_, input, size, cudaMemcpyHostToDevice));
     if (paddedSize > size) {
         CUDA_CHECK(cudaMemset(d_input_ + size, 0, paddedSize - size));
     }
-    CUDA_CHECK(cudaMemcpy(d_roundKeys_, roundKeys, sizeof(roundKeys), cudaMemcpyHostToDevice));
+    // A cached schedule that is already on the device is not re-uploaded.
+    if (roundKeys != uploadedKeys_) {
+        CUDA_CHECK(cudaMemcpy(d_roundKeys_, roundKeys->data(), sizeof(RoundKeyWords), cudaMemcpyHostToDevice));
+        uploadedKeys_ = roundKeys;
+    }
     CUDA_CHECK(cudaMemcpy(d_iv_, actualIV, 16, cudaMemcpyHostToDevice));
     
+    phase.next(Phase::Compute);
     constexpr int THREADS_PER_BLOCK = 256;
     int numCudaBlocks = (numBlocks + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
     
-    aesCtrEncryptKernel<<<numCudaBlocks, THREADS_PER_BLOCK>>>(
+    aesCtrEncryptKernel<AesKeyTraits<KeyBits>::ROUNDS><<<numCudaBlocks, THREADS_PER_BLOCK>>>(
         d_input_, d_output_, d_roundKeys_, d_iv_, numBlocks);
     
     CUDA_CHECK(cudaGetLastError());
     CUDA_CHECK(cudaDeviceSynchronize());
     
+    phase.next(Phase::TransferOut);
     CUDA_CHECK(cudaMemcpy(output, d_output_, size, cudaMemcpyDeviceToHost));
 #else
     throw std::runtime_error("CUDA not available");
 #endif
 }
 
-void AesCudaEngine::decrypt(const uint8_t* input, uint8_t* output, 
-                             size_t size, const uint8_t* key, size_t keyLen,
-                             const uint8_t* iv) {
+template <int KeyBits>
+void AesCudaEngine<KeyBits>::encryptBatch(const CipherJob* jobs, size_t count) {
+#ifdef HAS_CUDA
+    if (!initialized_) initialize();
+    
+    // Consecutive jobs with the same key share one schedule in the table.
+    PhaseScope phase(phases_, Phase::KeySchedule);
+    std::vector<CudaBatchJob> descs(count);
+    std::vector<uint32_t> roundKeys;
+    const uint8_t* previousKey = nullptr;
+    size_t numBlocks = 0;
+    for (size_t j = 0; j < count; ++j) {
+        const CipherJob& job = jobs[j];
+        AesKeyTraits<KeyBits>::checkKey(job.keyLen);
+        if (!previousKey || std::memcmp(job.key, previousKey, AesKeyTraits<KeyBits>::KEY_BYTES) != 0) {
+            auto words = AesKeyTraits<KeyBits>::roundKeyWords(job.key);
+            roundKeys.insert(roundKeys.end(), words->begin(), words->end());
+            previousKey = job.key;
+        }
+        descs[j].firstBlock = numBlocks;
+        descs[j].keyIndex = static_cast<uint32_t>(roundKeys.size() / std::tuple_size<RoundKeyWords>::value - 1);
+        descs[j].reserved = 0;
+        std::memcpy(descs[j].iv, job.iv ? job.iv : defaultIV_.data(), 16);
+        numBlocks += (job.size + 15) / 16;
+    }
+    if (numBlocks == 0) return;
+    
+    phase.next(Phase::Setup);
+    size_t paddedSize = numBlocks * 16;
+    if (paddedSize > allocatedSize_) {
+        if (d_input_) cudaFree(d_input_);
+        if (d_output_) cudaFree(d_output_);
+        CUDA_CHECK(cudaMalloc(&d_input_, paddedSize));
+        CUDA_CHECK(cudaMalloc(&d_output_, paddedSize));
+        allocatedSize_ = paddedSize;
+    }
+    if (count > batchJobsCapacity_) {
+        if (d_batchJobs_) cudaFree(d_batchJobs_);
+        CUDA_CHECK(cudaMalloc(&d_batchJobs_, count * sizeof(CudaBatchJob)));
+        batchJobsCapacity_ = count;
+    }
+    if (roundKeys.size() > batchKeysCapacity_) {
+        if (d_batchKeys_) cudaFree(d_batchKeys_);
+        CUDA_CHECK(cudaMalloc(&d_batchKeys_, roundKeys.size() * sizeof(uint32_t)));
+        batchKeysCapacity_ = roundKeys.size();
+    }
+    
+    // Jobs are packed block-aligned, zero-padded, into one staging buffer.
+    staging_.assign(paddedSize, 0);
+    for (size_t j = 0; j < count; ++j) {
+        std::memcpy(staging_.data() + descs[j].firstBlock * 16, jobs[j].input, jobs[j].size);
+    }
+    
+    phase.next(Phase::TransferIn);
+    CUDA_CHECK(cudaMemcpy(d_input_, staging_.data(), paddedSize, cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy(d_batchJobs_, descs.data(), count * sizeof(CudaBatchJob), cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy(d_batchKeys_, roundKeys.data(), roundKeys.size() * sizeof(uint32_t),
+                          cudaMemcpyHostToDevice));
+    
+    phase.next(Phase::Compute);
+    constexpr int THREADS_PER_BLOCK = 256;
+    int numCudaBlocks = (numBlocks + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    
+    aesCtrBatchKernel<AesKeyTraits<KeyBits>::ROUNDS><<<numCudaBlocks, THREADS_PER_BLOCK>>>(
+        d_input_, d_output_, d_batchKeys_, static_cast<const CudaBatchJob*>(d_batchJobs_), count, numBlocks);
+    
+    CUDA_CHECK(cudaGetLastError());
+    CUDA_CHECK(cudaDeviceSynchronize());
+    
+    phase.next(Phase::TransferOut);
+    CUDA_CHECK(cudaMemcpy(staging_.data(), d_output_, paddedSize, cudaMemcpyDeviceToHost));
+    for (size_t j = 0; j < count; ++j) {
+        std::memcpy(jobs[j].output, staging_.data() + descs[j].firstBlock * 16, jobs[j].size);
+    }
+#else
+    throw std::runtime_error("CUDA not available");
+#endif
+}
+
+template <int KeyBits>
+void AesCudaEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                      size_t size, const uint8_t* key, size_t keyLen,
+                                      const uint8_t* iv) {
     encrypt(input, output, size, key, keyLen, iv);
 }
 
+template class AesCudaEngine<128>;
+template class AesCudaEngine<192>;
+template class AesCudaEngine<256>;
+
 }
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
 #include <array>
+#include <memory>
+#include <vector>
 
 namespace hpc_benchmark {
 
+// AES-CTR with one GPU thread per block; instantiated for 128, 192 and
+// 256-bit keys, each with its own kernels unrolled for its round count.
+template <int KeyBits>
 class AesCudaEngine : public ICipherEngine {
 public:
     AesCudaEngine();
     ~AesCudaEngine() override;
     
-    std::string getAlgorithmName() const override { return "AES-256-CTR"; }
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("CTR"); }
     std::string getEngineName() const override { return "CUDA"; }
     
     void encrypt(const uint8_t* input, uint8_t* output, 
@@ -21,16 +27,31 @@ public:
                 size_t size, const uint8_t* key, size_t keyLen,
                 const uint8_t* iv = nullptr) override;
     
+    // Packs every job into one device buffer: one transfer in, one launch,
+    // one synchronize and one transfer out for the whole batch.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
     bool isAvailable() const override;
     void initialize() override;
     void cleanup() override;
     
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+
 private:
+    using RoundKeyWords = typename AesKeyTraits<KeyBits>::RoundKeyWords;
+    
+    
     uint8_t* d_input_;
     uint8_t* d_output_;
     uint32_t* d_roundKeys_;
     uint8_t* d_iv_;
+    std::shared_ptr<const RoundKeyWords> uploadedKeys_;  // schedule in d_roundKeys_
     size_t allocatedSize_;
+    void* d_batchJobs_;
+    size_t batchJobsCapacity_;
+    uint32_t* d_batchKeys_;
+    size_t batchKeysCapacity_;
+    std::vector<uint8_t> staging_;
     bool initialized_;
     std::array<uint8_t, 16> defaultIV_;
 };
@@ -0,0 +1,242 @@
+#include "aes_gcm_chunked.hpp"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+constexpr size_t NONCE_BYTES = 12;
+constexpr int GCM_TAG_BYTES = 16;
+constexpr uint64_t STREAM_TAG_INDEX = 1ull << 63;
+
+// TLS 1.3-style per-record nonce: big-endian index XORed into the low
+// 8 bytes of the base nonce.
+std::array<uint8_t, NONCE_BYTES> segmentNonce(const uint8_t* base, uint64_t index) {
+    std::array<uint8_t, NONCE_BYTES> nonce;
+    std::memcpy(nonce.data(), base, NONCE_BYTES);
+    for (int i = 0; i < 8; ++i) {
+        nonce[NONCE_BYTES - 1 - i] ^= static_cast<uint8_t>(index >> (8 * i));
+    }
+    return nonce;
+}
+
+// GMAC over (total length || segment tags) under the reserved nonce.
+bool streamTag(EVP_CIPHER_CTX* ctx, const EVP_CIPHER* cipher, const uint8_t* key,
+               const uint8_t* baseNonce, uint64_t size,
+               const std::vector<uint8_t>& segmentTags, uint8_t* tag) {
+    std::array<uint8_t, NONCE_BYTES> nonce = segmentNonce(baseNonce, STREAM_TAG_INDEX);
+    uint8_t length[8];
+    for (int i = 0; i < 8; ++i) {
+        length[7 - i] = static_cast<uint8_t>(size >> (8 * i));
+    }
+    
+    int outLen = 0;
+    EVP_CIPHER_CTX_reset(ctx);
+    return EVP_EncryptInit_ex(ctx, cipher, nullptr, key, nonce.data()) == 1 &&
+           EVP_EncryptUpdate(ctx, nullptr, &outLen, length, sizeof(length)) == 1 &&
+           EVP_EncryptUpdate(ctx, nullptr, &outLen, segmentTags.data(), static_cast<int>(segmentTags.size())) == 1 &&
+           EVP_EncryptFinal_ex(ctx, nullptr, &outLen) == 1 &&
+           EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, GCM_TAG_BYTES, tag) == 1;
+}
+
+}
+
+template <int KeyBits>
+AesGcmChunkedEngine<KeyBits>::AesGcmChunkedEngine(bool parallel) : parallel_(parallel) {
+    RAND_bytes(defaultIV_.data(), 16);
+}
+
+template <int KeyBits>
+AesGcmChunkedEngine<KeyBits>::~AesGcmChunkedEngine() {}
+
+template <int KeyBits>
+bool AesGcmChunkedEngine<KeyBits>::isAvailable() const {
+#ifdef HAS_OPENMP
+    return true;
+#else
+    return !parallel_;
+#endif
+}
+
+template <int KeyBits>
+void AesGcmChunkedEngine<KeyBits>::initialize() {
+    if (parallel_) {
+        tuned_ = TuningCache::shared().entriesFor(getAlgorithmName(), getEngineName());
+    }
+}
+
+template <int KeyBits>
+void AesGcmChunkedEngine<KeyBits>::setTuning(const OmpTuning& tuning) {
+    tuning_ = tuning;
+    tuningPinned_ = true;
+}
+
+template <int KeyBits>
+bool AesGcmChunkedEngine<KeyBits>::getTuning(size_t size, OmpTuning& tuning) const {
+    if (!parallel_) return false;
+    OmpTuning base = tuning_;
+    if (numThreads_ > 0) {
+        base.threads = numThreads_;
+    }
+    tuning = tuningPinned_ ? base : resolveTuning(tuned_, size, base);
+    return true;
+}
+
+template <int KeyBits>
+size_t AesGcmChunkedEngine<KeyBits>::prepareLoop(size_t size) const {
+    OmpTuning tuning;
+    if (!getTuning(size, tuning)) return 1;
+#ifdef HAS_OPENMP
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
+    }
+    applyOmpSchedule(tuning.schedule);
+#endif
+    return std::max<size_t>(1, tuning.chunkBytes / SEGMENT_BYTES);
+}
+
+template <int KeyBits>
+size_t AesGcmChunkedEngine<KeyBits>::getTagBytes(size_t size) const {
+    return ((size + SEGMENT_BYTES - 1) / SEGMENT_BYTES + 1) * TAG_BYTES;
+}
+
+template <int KeyBits>
+void AesGcmChunkedEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                            size_t size, const uint8_t* key, size_t keyLen,
+                                            const uint8_t* iv) {
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
+    
+    const uint8_t* actualIV = iv ? iv : defaultIV_.data();
+    const size_t numSegments = (size + SEGMENT_BYTES - 1) / SEGMENT_BYTES;
+    segmentTags_.assign(numSegments * TAG_BYTES, 0);
+    std::atomic<bool> failed{false};
+    
+    const size_t perItem = prepareLoop(size);
+    const size_t numItems = (numSegments + perItem - 1) / perItem;
+    
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel if (parallel_)
+    {
+        // The key schedule and GHASH key are set once per thread; each
+        // segment only re-inits the nonce.
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        if (EVP_EncryptInit_ex(ctx, AesKeyTraits<KeyBits>::gcm(), nullptr, key, nullptr) != 1) {
+            failed = true;
+        }
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t item = 0; item < numItems; ++item) {
+            const size_t lastSeg = std::min(numSegments, (item + 1) * perItem);
+            for (size_t seg = item * perItem; seg < lastSeg; ++seg) {
+                size_t offset = seg * SEGMENT_BYTES;
+                size_t len = std::min(SEGMENT_BYTES, size - offset);
+                std::array<uint8_t, NONCE_BYTES> nonce = segmentNonce(actualIV, seg);
+                
+                int outLen = 0;
+                bool ok = EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce.data()) == 1 &&
+                          EVP_EncryptUpdate(ctx, output + offset, &outLen, input + offset, static_cast<int>(len)) == 1 &&
+                          EVP_EncryptFinal_ex(ctx, output + offset + outLen, &outLen) == 1 &&
+                          EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, TAG_BYTES,
+                                              segmentTags_.data() + seg * TAG_BYTES) == 1;
+                if (!ok) failed = true;
+            }
+        }
+        
+        #pragma omp master
+        region.workDone();
+        
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    region.finish();
+    
+    // Aggregation is serial and counted as Teardown.
+    PhaseScope phase(phases_, Phase::Teardown);
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    bool ok = streamTag(ctx, AesKeyTraits<KeyBits>::gcm(), key, actualIV, size,
+                        segmentTags_, streamTag_.data());
+    EVP_CIPHER_CTX_free(ctx);
+    
+    if (failed || !ok) {
+        throw std::runtime_error("AES-GCM segment encryption failed");
+    }
+}
+
+template <int KeyBits>
+void AesGcmChunkedEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                            size_t size, const uint8_t* key, size_t keyLen,
+                                            const uint8_t* iv) {
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
+    
+    const uint8_t* actualIV = iv ? iv : defaultIV_.data();
+    const size_t numSegments = (size + SEGMENT_BYTES - 1) / SEGMENT_BYTES;
+    if (segmentTags_.size() != numSegments * TAG_BYTES) {
+        throw std::runtime_error(getAlgorithmName() + ": no tags for a stream of this size");
+    }
+    
+    // The stream tag is checked first so reordered or truncated segment
+    // tags are rejected before any plaintext is released.
+    std::array<uint8_t, TAG_BYTES> expected;
+    EVP_CIPHER_CTX* tagCtx = EVP_CIPHER_CTX_new();
+    bool ok = streamTag(tagCtx, AesKeyTraits<KeyBits>::gcm(), key, actualIV, size,
+                        segmentTags_, expected.data());
+    EVP_CIPHER_CTX_free(tagCtx);
+    if (!ok || CRYPTO_memcmp(expected.data(), streamTag_.data(), TAG_BYTES) != 0) {
+        throw std::runtime_error(getAlgorithmName() + " stream tag authentication failed");
+    }
+    
+    std::atomic<bool> failed{false};
+    
+    const size_t perItem = prepareLoop(size);
+    const size_t numItems = (numSegments + perItem - 1) / perItem;
+    
+    #pragma omp parallel if (parallel_)
+    {
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        if (EVP_DecryptInit_ex(ctx, AesKeyTraits<KeyBits>::gcm(), nullptr, key, nullptr) != 1) {
+            failed = true;
+        }
+        
+        #pragma omp for schedule(runtime)
+        for (size_t item = 0; item < numItems; ++item) {
+            const size_t lastSeg = std::min(numSegments, (item + 1) * perItem);
+            for (size_t seg = item * perItem; seg < lastSeg; ++seg) {
+                size_t offset = seg * SEGMENT_BYTES;
+                size_t len = std::min(SEGMENT_BYTES, size - offset);
+                std::array<uint8_t, NONCE_BYTES> nonce = segmentNonce(actualIV, seg);
+                
+                int outLen = 0;
+                bool segOk = EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce.data()) == 1 &&
+                             EVP_DecryptUpdate(ctx, output + offset, &outLen, input + offset, static_cast<int>(len)) == 1 &&
+                             EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, TAG_BYTES,
+                                                 segmentTags_.data() + seg * TAG_BYTES) == 1 &&
+                             EVP_DecryptFinal_ex(ctx, output + offset + outLen, &outLen) == 1;
+                if (!segOk) failed = true;
+            }
+        }
+        
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    if (failed) {
+        throw std::runtime_error(getAlgorithmName() + " segment authentication failed");
+    }
+}
+
+template class AesGcmChunkedEngine<128>;
+template class AesGcmChunkedEngine<192>;
+template class AesGcmChunkedEngine<256>;
+
+}
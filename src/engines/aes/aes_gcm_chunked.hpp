@@ -0,0 +1,74 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
+#include <array>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// AES-GCM over independent 64 KB segments. Segment i is sealed under the
+// base nonce XOR i and gets its own tag; a final GMAC under a nonce outside
+// the segment range binds the total length and every segment tag into one
+// stream tag. Segments need no shared GHASH state, so they run in parallel.
+//
+// Tags of the last encrypt() stay in the engine and are what decrypt()
+// authenticates against, standing in for the tag stream a container would
+// carry next to the ciphertext.
+template <int KeyBits>
+class AesGcmChunkedEngine : public ICipherEngine {
+public:
+    static constexpr size_t SEGMENT_BYTES = 64 * 1024;
+    static constexpr size_t TAG_BYTES = 16;
+    
+    // parallel = false seals the same segments on the calling thread; it is
+    // the Sequential reference for the chunked format.
+    explicit AesGcmChunkedEngine(bool parallel = true);
+    ~AesGcmChunkedEngine() override;
+    
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("GCM-Chunked"); }
+    std::string getEngineName() const override { return parallel_ ? "OpenMP" : "Sequential"; }
+    
+    void encrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    // Throws if a segment tag or the stream tag does not authenticate.
+    void decrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    bool isAvailable() const override;
+    void initialize() override;
+    
+    void setNumThreads(int threads) override { numThreads_ = threads; }
+    
+    // OpenMP variant only: schedule and segments per work item
+    // (chunkBytes / SEGMENT_BYTES, at least one); pinning bypasses the
+    // tuning cache. The segment size itself is part of the format.
+    void setTuning(const OmpTuning& tuning) override;
+    bool getTuning(size_t size, OmpTuning& tuning) const override;
+    
+    // One tag per segment plus the stream tag.
+    size_t getTagBytes(size_t size) const override;
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+
+private:
+    // Applies the tuning for a size-byte call; returns segments per work item.
+    size_t prepareLoop(size_t size) const;
+    
+    bool parallel_;
+    int numThreads_ = 0;
+    OmpTuning tuning_{0, OmpSchedule::Static, SEGMENT_BYTES};
+    bool tuningPinned_ = false;
+    std::vector<TuningEntry> tuned_;
+    std::vector<uint8_t> segmentTags_;
+    std::array<uint8_t, TAG_BYTES> streamTag_{};
+    std::array<uint8_t, 16> defaultIV_;
+};
+
+extern template class AesGcmChunkedEngine<128>;
+extern template class AesGcmChunkedEngine<192>;
+extern template class AesGcmChunkedEngine<256>;
+
+}
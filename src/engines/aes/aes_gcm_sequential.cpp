@@ -0,0 +1,104 @@
+#include "aes_gcm_sequential.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+#include <cstring>
+#include <array>
+
+namespace hpc_benchmark {
+
+template <int KeyBits>
+struct AesGcmSequentialEngine<KeyBits>::Impl {
+    EVP_CIPHER_CTX* ctx = nullptr;
+    std::array<uint8_t, 16> defaultIV;
+    std::array<uint8_t, 16> tag{};
+    
+    Impl() {
+        ctx = EVP_CIPHER_CTX_new();
+        RAND_bytes(defaultIV.data(), 16);
+    }
+    
+    ~Impl() {
+        if (ctx) EVP_CIPHER_CTX_free(ctx);
+    }
+};
+
+template <int KeyBits>
+AesGcmSequentialEngine<KeyBits>::AesGcmSequentialEngine() : impl_(new Impl()) {}
+
+template <int KeyBits>
+AesGcmSequentialEngine<KeyBits>::~AesGcmSequentialEngine() {
+    cleanup();
+    delete impl_;
+}
+
+template <int KeyBits>
+bool AesGcmSequentialEngine<KeyBits>::isAvailable() const {
+    return true;
+}
+
+template <int KeyBits>
+void AesGcmSequentialEngine<KeyBits>::initialize() {}
+
+template <int KeyBits>
+void AesGcmSequentialEngine<KeyBits>::cleanup() {}
+
+template <int KeyBits>
+void AesGcmSequentialEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                               size_t size, const uint8_t* key, size_t keyLen,
+                                               const uint8_t* iv) {
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
+    
+    const uint8_t* actualIV = iv ? iv : impl_->defaultIV.data();
+    
+    PhaseScope phase(phases_, Phase::Setup);
+    EVP_CIPHER_CTX_reset(impl_->ctx);
+    
+    phase.next(Phase::KeySchedule);
+    if (EVP_EncryptInit_ex(impl_->ctx, AesKeyTraits<KeyBits>::gcm(), nullptr, key, actualIV) != 1) {
+        throw std::runtime_error("EVP_EncryptInit_ex failed");
+    }
+    
+    phase.next(Phase::Compute);
+    int outLen = 0;
+    if (EVP_EncryptUpdate(impl_->ctx, output, &outLen, input, static_cast<int>(size)) != 1) {
+        throw std::runtime_error("EVP_EncryptUpdate failed");
+    }
+    
+    // The final GHASH block and tag are reported as Teardown.
+    phase.next(Phase::Teardown);
+    if (EVP_EncryptFinal_ex(impl_->ctx, output + outLen, &outLen) != 1 ||
+        EVP_CIPHER_CTX_ctrl(impl_->ctx, EVP_CTRL_AEAD_GET_TAG, 16, impl_->tag.data()) != 1) {
+        throw std::runtime_error("AES-GCM tag generation failed");
+    }
+}
+
+template <int KeyBits>
+void AesGcmSequentialEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                               size_t size, const uint8_t* key, size_t keyLen,
+                                               const uint8_t* iv) {
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
+    
+    const uint8_t* actualIV = iv ? iv : impl_->defaultIV.data();
+    
+    EVP_CIPHER_CTX_reset(impl_->ctx);
+    if (EVP_DecryptInit_ex(impl_->ctx, AesKeyTraits<KeyBits>::gcm(), nullptr, key, actualIV) != 1) {
+        throw std::runtime_error("EVP_DecryptInit_ex failed");
+    }
+    
+    int outLen = 0;
+    if (EVP_DecryptUpdate(impl_->ctx, output, &outLen, input, static_cast<int>(size)) != 1) {
+        throw std::runtime_error("EVP_DecryptUpdate failed");
+    }
+    
+    EVP_CIPHER_CTX_ctrl(impl_->ctx, EVP_CTRL_AEAD_SET_TAG, 16, impl_->tag.data());
+    if (EVP_DecryptFinal_ex(impl_->ctx, output + outLen, &outLen) != 1) {
+        throw std::runtime_error(getAlgorithmName() + " authentication failed");
+    }
+}
+
+template class AesGcmSequentialEngine<128>;
+template class AesGcmSequentialEngine<192>;
+template class AesGcmSequentialEngine<256>;
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
+#include <array>
+
+namespace hpc_benchmark {
+
+// Single-stream AES-GCM through EVP. GHASH chains every block into one
+// tag, so the stream cannot be split across threads.
+template <int KeyBits>
+class AesGcmSequentialEngine : public ICipherEngine {
+public:
+    AesGcmSequentialEngine();
+    ~AesGcmSequentialEngine() override;
+    
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("GCM"); }
+    std::string getEngineName() const override { return "Sequential"; }
+    
+    // Uses the first 12 bytes of iv as the GCM nonce.
+    void encrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    // Authenticates against the tag of the last encrypt(); throws on mismatch.
+    void decrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    bool isAvailable() const override;
+    void initialize() override;
+    void cleanup() override;
+    
+    size_t getTagBytes(size_t) const override { return 16; }
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+    
+private:
+    struct Impl;
+    Impl* impl_;
+};
+
+extern template class AesGcmSequentialEngine<128>;
+extern template class AesGcmSequentialEngine<192>;
+extern template class AesGcmSequentialEngine<256>;
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "kernels/aes_tables.hpp"
+#include "common/key_schedule_cache.hpp"
+#include <openssl/evp.h>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace hpc_benchmark {
+
+// Per-key-size constants for the EVP engines. Each engine is instantiated
+// once per key size, so the cipher lookup and key check fold to constants.
+template <int KeyBits>
+struct AesKeyTraits {
+    static constexpr size_t KEY_BYTES = aes::KeySize<KeyBits>::KEY_BYTES;
+    static constexpr int ROUNDS = aes::KeySize<KeyBits>::ROUNDS;
+    
+    using RoundKeyWords = std::array<uint32_t, aes::KeySize<KeyBits>::SCHEDULE_WORDS>;
+    
+    // "AES-128-CTR", "AES-256-GCM-Chunked", ...
+    static std::string algorithmName(const char* mode) {
+        return "AES-" + std::to_string(KeyBits) + "-" + mode;
+    }
+    
+    static void checkKey(size_t keyLen) {
+        if (keyLen != KEY_BYTES) {
+            throw std::runtime_error("AES-" + std::to_string(KeyBits) + " requires " +
+                                     std::to_string(KEY_BYTES) + "-byte key");
+        }
+    }
+    
+    static const EVP_CIPHER* ctr() {
+        if constexpr (KeyBits == 128) return EVP_aes_128_ctr();
+        else if constexpr (KeyBits == 192) return EVP_aes_192_ctr();
+        else return EVP_aes_256_ctr();
+    }
+    
+    static const EVP_CIPHER* gcm() {
+        if constexpr (KeyBits == 128) return EVP_aes_128_gcm();
+        else if constexpr (KeyBits == 192) return EVP_aes_192_gcm();
+        else return EVP_aes_256_gcm();
+    }
+    
+    // aes::keyExpansion output, from the key schedule cache when enabled.
+    static std::shared_ptr<const RoundKeyWords> roundKeyWords(const uint8_t* key) {
+        auto build = [key] {
+            auto words = std::make_shared<RoundKeyWords>();
+            aes::keyExpansion<KeyBits>(key, words->data());
+            return std::shared_ptr<const RoundKeyWords>(words);
+        };
+        KeyScheduleCache& cache = KeyScheduleCache::shared();
+        if (!cache.enabled()) return build();
+        static const std::string kind = algorithmName("words");
+        return cache.get<RoundKeyWords>(kind, key, KEY_BYTES, build);
+    }
+    
+    // Keys ctx for CTR at iv. With the key schedule cache enabled this copies
+    // a cached keyed context instead of fetching the cipher and expanding the
+    // key again.
+    static bool initCtr(EVP_CIPHER_CTX* ctx, const uint8_t* key, const uint8_t* iv) {
+        return initCtr(ctx, ctr(), key, iv);
+    }
+    
+    // Same with the cipher handle the engine resolved (see evp_usage.hpp).
+    static bool initCtr(EVP_CIPHER_CTX* ctx, const EVP_CIPHER* cipher, const uint8_t* key, const uint8_t* iv) {
+        if (!KeyScheduleCache::shared().enabled()) {
+            return EVP_EncryptInit_ex(ctx, cipher, nullptr, key, iv) == 1;
+        }
+        return EVP_CIPHER_CTX_copy(ctx, keyedCtr(cipher, key).get()) == 1 &&
+               EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) == 1;
+    }
+    
+    // Puts the keyed CTR context initCtr() copies into the cache ahead of
+    // use (ICipherEngine::prepareKey).
+    static void prepareCtr(const uint8_t* key) {
+        prepareCtr(ctr(), key);
+    }
+    
+    static void prepareCtr(const EVP_CIPHER* cipher, const uint8_t* key) {
+        if (KeyScheduleCache::shared().enabled()) {
+            keyedCtr(cipher, key);
+        }
+    }
+
+private:
+    // Implicit and fetched cipher handles live until exit, so keying entries
+    // by the handle keeps --evp-usage variants from copying each other's
+    // contexts.
+    static std::shared_ptr<const EVP_CIPHER_CTX> keyedCtr(const EVP_CIPHER* cipher, const uint8_t* key) {
+        static const std::string kind = "EVP " + algorithmName("CTR");
+        return KeyScheduleCache::shared().get<EVP_CIPHER_CTX>(kind, cipher, key, KEY_BYTES, [cipher, key] {
+            EVP_CIPHER_CTX* c = EVP_CIPHER_CTX_new();
+            if (EVP_EncryptInit_ex(c, cipher, nullptr, key, nullptr) != 1) {
+                EVP_CIPHER_CTX_free(c);
+                throw std::runtime_error("EVP_EncryptInit_ex failed");
+            }
+            return std::shared_ptr<const EVP_CIPHER_CTX>(c, EVP_CIPHER_CTX_free);
+        });
+    }
+};
+
+}
@@ -1,16 +1,20 @@
 #pragma once
 
 #include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
 #include <array>
 
 namespace hpc_benchmark {
 
+// AES-CTR with one GPU thread per block; instantiated for 128, 192 and
+// 256-bit keys. The shader is compiled with the round count as a constant.
+template <int KeyBits>
 class AesMetalEngine : public ICipherEngine {
 public:
     AesMetalEngine();
     ~AesMetalEngine() override;
     
-    std::string getAlgorithmName() const override { return "AES-256-CTR"; }
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("CTR"); }
     std::string getEngineName() const override { return "Metal"; }
     
     void encrypt(const uint8_t* input, uint8_t* output, 
@@ -25,6 +29,8 @@ public:
     void initialize() override;
     void cleanup() override;
     
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+
 private:
     struct Impl;
     Impl* impl_;
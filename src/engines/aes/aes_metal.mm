@@ -1,5 +1,5 @@
 #include "aes_metal.hpp"
-#include "kernels/aes_tables.hpp"
+#include "engines/aes/aes_key_size.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
@@ -12,7 +12,8 @@
 namespace hpc_benchmark {
 
 #ifdef HAS_METAL
-struct AesMetalEngine::Impl {
+template <int KeyBits>
+struct AesMetalEngine<KeyBits>::Impl {
     id<MTLDevice> device = nil;
     id<MTLCommandQueue> commandQueue = nil;
     id<MTLComputePipelineState> pipelineState = nil;
@@ -26,11 +27,17 @@ struct AesMetalEngine::Impl {
     }
 };
 
+// Compiled with AES_ROUNDS = 10, 12 or 14; the schedule holds
+// 4 * (AES_ROUNDS + 1) words.
 static NSString* getAesShaderSource() {
     return @R"(
 #include <metal_stdlib>
 using namespace metal;
 
+#ifndef AES_ROUNDS
+#define AES_ROUNDS 14
+#endif
+
 constant uchar SBOX[256] = {
     0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
     0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
@@ -107,10 +114,10 @@ kernel void aes_ctr_encrypt(device const uchar4* input [[buffer(0)]],
     
     for (int i = 0; i < 16; i++) counter[i] ^= roundKeys[i];
     
-    for (int round = 1; round < 14; round++) {
+    for (int round = 1; round < AES_ROUNDS; round++) {
         aes_round(counter, roundKeys + round * 16);
     }
-    aes_final_round(counter, roundKeys + 14 * 16);
+    aes_final_round(counter, roundKeys + AES_ROUNDS * 16);
     
     ulong offset = blockIdx * 4;
     uchar4 in0 = input[offset];
@@ -130,19 +137,23 @@ kernel void aes_ctr_encrypt(device const uchar4* input [[buffer(0)]],
 )";
 }
 #else
-struct AesMetalEngine::Impl {};
+template <int KeyBits>
+struct AesMetalEngine<KeyBits>::Impl {};
 #endif
 
-AesMetalEngine::AesMetalEngine() : impl_(new Impl()), initialized_(false) {
+template <int KeyBits>
+AesMetalEngine<KeyBits>::AesMetalEngine() : impl_(new Impl()), initialized_(false) {
     for (int i = 0; i < 16; i++) defaultIV_[i] = static_cast<uint8_t>(i);
 }
 
-AesMetalEngine::~AesMetalEngine() {
+template <int KeyBits>
+AesMetalEngine<KeyBits>::~AesMetalEngine() {
     cleanup();
     delete impl_;
 }
 
-bool AesMetalEngine::isAvailable() const {
+template <int KeyBits>
+bool AesMetalEngine<KeyBits>::isAvailable() const {
 #ifdef HAS_METAL
     @autoreleasepool {
         id<MTLDevice> device = MTLCreateSystemDefaultDevice();
@@ -153,7 +164,8 @@ bool AesMetalEngine::isAvailable() const {
 #endif
 }
 
-void AesMetalEngine::initialize() {
+template <int KeyBits>
+void AesMetalEngine<KeyBits>::initialize() {
 #ifdef HAS_METAL
     if (initialized_) return;
     
@@ -166,6 +178,7 @@ void AesMetalEngine::initialize() {
         
         NSError* error = nil;
         MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
+        options.preprocessorMacros = @{@"AES_ROUNDS": @(AesKeyTraits<KeyBits>::ROUNDS)};
         
         impl_->library = [impl_->device newLibraryWithSource:getAesShaderSource()
                                                      options:options
@@ -188,7 +201,8 @@ void AesMetalEngine::initialize() {
 #endif
 }
 
-void AesMetalEngine::cleanup() {
+template <int KeyBits>
+void AesMetalEngine<KeyBits>::cleanup() {
 #ifdef HAS_METAL
     @autoreleasepool {
         impl_->pipelineState = nil;
@@ -200,30 +214,33 @@ void AesMetalEngine::cleanup() {
 #endif
 }
 
-void AesMetalEngine::encrypt(const uint8_t* input, uint8_t* output, 
-                              size_t size, const uint8_t* key, size_t keyLen,
-                              const uint8_t* iv) {
+template <int KeyBits>
+void AesMetalEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                       size_t size, const uint8_t* key, size_t keyLen,
+                                       const uint8_t* iv) {
 #ifdef HAS_METAL
-    if (keyLen != 32) throw std::runtime_error("AES-256 requires 32-byte key");
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
     if (!initialized_) initialize();
     
     const uint8_t* actualIV = iv ? iv : defaultIV_.data();
     
-    uint32_t roundKeysU32[60];
-    aes::keyExpansion256(key, roundKeysU32);
+    PhaseScope phase(phases_, Phase::KeySchedule);
+    auto roundKeysU32 = AesKeyTraits<KeyBits>::roundKeyWords(key);
+    constexpr int SCHEDULE_WORDS = aes::KeySize<KeyBits>::SCHEDULE_WORDS;
     
-    uint8_t roundKeys[240];
-    for (int i = 0; i < 60; i++) {
-        roundKeys[i*4]   = (roundKeysU32[i] >> 0) & 0xFF;
-        roundKeys[i*4+1] = (roundKeysU32[i] >> 8) & 0xFF;
-        roundKeys[i*4+2] = (roundKeysU32[i] >> 16) & 0xFF;
-        roundKeys[i*4+3] = (roundKeysU32[i] >> 24) & 0xFF;
+    uint8_t roundKeys[SCHEDULE_WORDS * 4];
+    for (int i = 0; i < SCHEDULE_WORDS; i++) {
+        roundKeys[i*4]   = ((*roundKeysU32)[i] >> 0) & 0xFF;
+        roundKeys[i*4+1] = ((*roundKeysU32)[i] >> 8) & 0xFF;
+        roundKeys[i*4+2] = ((*roundKeysU32)[i] >> 16) & 0xFF;
+        roundKeys[i*4+3] = ((*roundKeysU32)[i] >> 24) & 0xFF;
     }
     
     @autoreleasepool {
         size_t paddedSize = ((size + 15) / 16) * 16;
         size_t numBlocks = paddedSize / 16;
         
+        phase.next(Phase::TransferIn);
         std::vector<uint8_t> paddedInput(paddedSize, 0);
         std::memcpy(paddedInput.data(), input, size);
         
@@ -241,6 +258,7 @@ void AesMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
         
         uint64_t numBlocksU = static_cast<uint64_t>(numBlocks);
         
+        phase.next(Phase::Compute);
         id<MTLCommandBuffer> commandBuffer = [impl_->commandQueue commandBuffer];
         id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
         
@@ -264,8 +282,10 @@ void AesMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
         [commandBuffer commit];
         [commandBuffer waitUntilCompleted];
         
+        phase.next(Phase::TransferOut);
         std::memcpy(output, [outputBuffer contents], size);
         
+        phase.next(Phase::Teardown);
         [inputBuffer setPurgeableState:MTLPurgeableStateEmpty];
         [outputBuffer setPurgeableState:MTLPurgeableStateEmpty];
         [keyBuffer setPurgeableState:MTLPurgeableStateEmpty];
@@ -281,10 +301,15 @@ void AesMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
 #endif
 }
 
-void AesMetalEngine::decrypt(const uint8_t* input, uint8_t* output, 
-                              size_t size, const uint8_t* key, size_t keyLen,
-                              const uint8_t* iv) {
+template <int KeyBits>
+void AesMetalEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                       size_t size, const uint8_t* key, size_t keyLen,
+                                       const uint8_t* iv) {
     encrypt(input, output, size, key, keyLen, iv);
 }
 
+template class AesMetalEngine<128>;
+template class AesMetalEngine<192>;
+template class AesMetalEngine<256>;
+
 }
@@ -1,6 +1,10 @@
 #include <metal_stdlib>
 using namespace metal;
 
+#ifndef AES_ROUNDS
+#define AES_ROUNDS 14
+#endif
+
 constant uchar SBOX[256] = {
     0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
     0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
@@ -61,16 +65,18 @@ void aes_final_round(thread uchar* state, device const uchar* roundKey) {
     for (int i = 0; i < 16; i++) state[i] = tmp[i] ^ roundKey[i];
 }
 
-void aes256_encrypt_block(thread uchar* block, device const uint* roundKeys) {
+// AES_ROUNDS is 10, 12 or 14 (AES-128/192/256); the schedule holds
+// 4 * (AES_ROUNDS + 1) words.
+void aes_encrypt_block(thread uchar* block, device const uint* roundKeys) {
     device const uchar* rk = (device const uchar*)roundKeys;
     
     for (int i = 0; i < 16; i++) block[i] ^= rk[i];
     
-    for (int round = 1; round < 14; round++) {
+    for (int round = 1; round < AES_ROUNDS; round++) {
         aes_round(block, rk + round * 16);
     }
     
-    aes_final_round(block, rk + 14 * 16);
+    aes_final_round(block, rk + AES_ROUNDS * 16);
 }
 
 kernel void aes_ctr_encrypt(device const uchar* input [[buffer(0)]],
@@ -91,7 +97,7 @@ kernel void aes_ctr_encrypt(device const uchar* input [[buffer(0)]],
         ctr = (ctr >> 8) + (sum >> 8);
     }
     
-    aes256_encrypt_block(counter, roundKeys);
+    aes_encrypt_block(counter, roundKeys);
     
     ulong offset = blockIdx * 16;
     for (int i = 0; i < 16; i++) {
@@ -0,0 +1,147 @@
+#include "aes_multibuffer.hpp"
+#include "kernels/aes_multibuffer.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+#include <cstring>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace hpc_benchmark {
+
+template <int KeyBits>
+struct AesMultiBufferEngine<KeyBits>::Impl {
+    static constexpr size_t SCHEDULE_BYTES = (AesKeyTraits<KeyBits>::ROUNDS + 1) * 16;
+    using ScheduleBytes = std::array<uint8_t, SCHEDULE_BYTES>;
+    
+    bool useKernel;
+    EVP_CIPHER_CTX* ctx = nullptr;
+    std::array<uint8_t, 16> defaultIV;
+    
+    // Scratch reused across batches: one schedule per distinct key run.
+    std::vector<uint8_t> schedules;
+    std::vector<aes::CtrJob> ctrJobs;
+    // Schedules borrowed from the key schedule cache for the current batch.
+    std::vector<std::shared_ptr<const ScheduleBytes>> cached;
+    
+    Impl() : useKernel(aes::multiBufferSupported()) {
+        ctx = EVP_CIPHER_CTX_new();
+        RAND_bytes(defaultIV.data(), 16);
+    }
+    
+    ~Impl() {
+        if (ctx) EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    static std::shared_ptr<const ScheduleBytes> cachedSchedule(const uint8_t* key) {
+        static const std::string kind = "AES-NI " + AesKeyTraits<KeyBits>::algorithmName("schedule");
+        return KeyScheduleCache::shared().get<ScheduleBytes>(kind, key, AesKeyTraits<KeyBits>::KEY_BYTES, [key] {
+            auto bytes = std::make_shared<ScheduleBytes>();
+            aes::roundKeyBytes<KeyBits>(key, bytes->data());
+            return std::shared_ptr<const ScheduleBytes>(bytes);
+        });
+    }
+    
+    void evpEncrypt(const CipherJob& job, const uint8_t* iv) {
+        int outLen = 0;
+        EVP_CIPHER_CTX_reset(ctx);
+        if (!AesKeyTraits<KeyBits>::initCtr(ctx, job.key, iv) ||
+            EVP_EncryptUpdate(ctx, job.output, &outLen, job.input, static_cast<int>(job.size)) != 1) {
+            throw std::runtime_error("AES multi-buffer EVP fallback failed");
+        }
+    }
+};
+
+template <int KeyBits>
+AesMultiBufferEngine<KeyBits>::AesMultiBufferEngine() : impl_(new Impl()) {}
+
+template <int KeyBits>
+AesMultiBufferEngine<KeyBits>::~AesMultiBufferEngine() {
+    delete impl_;
+}
+
+template <int KeyBits>
+void AesMultiBufferEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                             size_t size, const uint8_t* key, size_t keyLen,
+                                             const uint8_t* iv) {
+    CipherJob job{input, output, size, key, keyLen, iv};
+    encryptBatch(&job, 1);
+}
+
+template <int KeyBits>
+void AesMultiBufferEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                             size_t size, const uint8_t* key, size_t keyLen,
+                                             const uint8_t* iv) {
+    encrypt(input, output, size, key, keyLen, iv);
+}
+
+template <int KeyBits>
+void AesMultiBufferEngine<KeyBits>::encryptBatch(const CipherJob* jobs, size_t count) {
+    for (size_t j = 0; j < count; ++j) {
+        AesKeyTraits<KeyBits>::checkKey(jobs[j].keyLen);
+    }
+    
+    PhaseScope phase(phases_, Phase::Setup);
+    
+    if (!impl_->useKernel) {
+        phase.next(Phase::Compute);
+        for (size_t j = 0; j < count; ++j) {
+            impl_->evpEncrypt(jobs[j], jobs[j].iv ? jobs[j].iv : impl_->defaultIV.data());
+        }
+        return;
+    }
+    
+    // Size the schedule store for the worst case first, so pointers into it
+    // stay valid while the job list is built.
+    const size_t scheduleBytes = Impl::SCHEDULE_BYTES;
+    if (impl_->schedules.size() < count * scheduleBytes) {
+        impl_->schedules.resize(count * scheduleBytes);
+    }
+    impl_->ctrJobs.resize(count);
+    
+    phase.next(Phase::KeySchedule);
+    const bool useCache = KeyScheduleCache::shared().enabled();
+    impl_->cached.clear();
+    
+    const uint8_t* previousKey = nullptr;
+    const uint8_t* schedule = nullptr;
+    size_t used = 0;
+    for (size_t j = 0; j < count; ++j) {
+        const CipherJob& job = jobs[j];
+        if (!previousKey || (job.key != previousKey &&
+                             std::memcmp(job.key, previousKey, AesKeyTraits<KeyBits>::KEY_BYTES) != 0)) {
+            if (useCache) {
+                impl_->cached.push_back(Impl::cachedSchedule(job.key));
+                schedule = impl_->cached.back()->data();
+            } else {
+                uint8_t* expanded = impl_->schedules.data() + used * scheduleBytes;
+                aes::roundKeyBytes<KeyBits>(job.key, expanded);
+                schedule = expanded;
+                ++used;
+            }
+            previousKey = job.key;
+        }
+        impl_->ctrJobs[j] = aes::CtrJob{schedule, job.iv ? job.iv : impl_->defaultIV.data(),
+                                        job.input, job.output, job.size};
+    }
+    
+    phase.next(Phase::Compute);
+    aes::ctrMultiBuffer(impl_->ctrJobs.data(), count, AesKeyTraits<KeyBits>::ROUNDS);
+}
+
+template <int KeyBits>
+void AesMultiBufferEngine<KeyBits>::prepareKey(const uint8_t* key, size_t keyLen) {
+    if (keyLen != AesKeyTraits<KeyBits>::KEY_BYTES || !KeyScheduleCache::shared().enabled()) return;
+    if (impl_->useKernel) {
+        Impl::cachedSchedule(key);
+    } else {
+        AesKeyTraits<KeyBits>::prepareCtr(key);
+    }
+}
+
+template class AesMultiBufferEngine<128>;
+template class AesMultiBufferEngine<192>;
+template class AesMultiBufferEngine<256>;
+
+}
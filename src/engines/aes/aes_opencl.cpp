@@ -1,5 +1,5 @@
 #include "aes_opencl.hpp"
-#include "kernels/aes_tables.hpp"
+#include "engines/aes/aes_key_size.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
@@ -18,7 +18,8 @@
 namespace hpc_benchmark {
 
 #ifdef HAS_OPENCL
-struct AesOpenCLEngine::Impl {
+template <int KeyBits>
+struct AesOpenCLEngine<KeyBits>::Impl {
     cl_context context = nullptr;
     cl_command_queue queue = nullptr;
     cl_program program = nullptr;
@@ -34,7 +35,13 @@ struct AesOpenCLEngine::Impl {
     }
 };
 
+// Built with -DAES_ROUNDS=10, 12 or 14; the schedule holds
+// 4 * (AES_ROUNDS + 1) words.
 static const char* AES_CTR_KERNEL_SOURCE = R"(
+#ifndef AES_ROUNDS
+#define AES_ROUNDS 14
+#endif
+
 __constant uchar SBOX[256] = {
     0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
     0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
@@ -99,16 +106,16 @@ void aes_final_round(uchar* state, __global const uchar* roundKey) {
     for (int i = 0; i < 16; i++) state[i] = tmp[i] ^ roundKey[i];
 }
 
-void aes256_encrypt_block(uchar* block, __global const uint* roundKeys) {
+void aes_encrypt_block(uchar* block, __global const uint* roundKeys) {
     __global const uchar* rk = (__global const uchar*)roundKeys;
     
     for (int i = 0; i < 16; i++) block[i] ^= rk[i];
     
-    for (int round = 1; round < 14; round++) {
+    for (int round = 1; round < AES_ROUNDS; round++) {
         aes_round(block, rk + round * 16);
     }
     
-    aes_final_round(block, rk + 14 * 16);
+    aes_final_round(block, rk + AES_ROUNDS * 16);
 }
 
 __kernel void aes_ctr_encrypt(__global const uchar* input,
@@ -129,7 +136,7 @@ __kernel void aes_ctr_encrypt(__global const uchar* input,
         ctr = (ctr >> 8) + (sum >> 8);
     }
     
-    aes256_encrypt_block(counter, roundKeys);
+    aes_encrypt_block(counter, roundKeys);
     
     size_t offset = blockIdx * 16;
     for (int i = 0; i < 16; i++) {
@@ -138,21 +145,25 @@ __kernel void aes_ctr_encrypt(__global const uchar* input,
 }
 )";
 #else
-struct AesOpenCLEngine::Impl {};
+template <int KeyBits>
+struct AesOpenCLEngine<KeyBits>::Impl {};
 #endif
 
-AesOpenCLEngine::AesOpenCLEngine() : impl_(new Impl()), initialized_(false) {
+template <int KeyBits>
+AesOpenCLEngine<KeyBits>::AesOpenCLEngine() : impl_(new Impl()), initialized_(false) {
 #ifdef HAS_OPENCL
     for (int i = 0; i < 16; i++) impl_->defaultIV[i] = static_cast<uint8_t>(i);
 #endif
 }
 
-AesOpenCLEngine::~AesOpenCLEngine() {
+template <int KeyBits>
+AesOpenCLEngine<KeyBits>::~AesOpenCLEngine() {
     cleanup();
     delete impl_;
 }
 
-bool AesOpenCLEngine::isAvailable() const {
+template <int KeyBits>
+bool AesOpenCLEngine<KeyBits>::isAvailable() const {
 #ifdef HAS_OPENCL
     cl_uint numPlatforms = 0;
     cl_int err = clGetPlatformIDs(0, nullptr, &numPlatforms);
@@ -162,7 +173,8 @@ bool AesOpenCLEngine::isAvailable() const {
 #endif
 }
 
-void AesOpenCLEngine::initialize() {
+template <int KeyBits>
+void AesOpenCLEngine<KeyBits>::initialize() {
 #ifdef HAS_OPENCL
     if (initialized_) return;
     
@@ -189,7 +201,8 @@ void AesOpenCLEngine::initialize() {
     impl_->program = clCreateProgramWithSource(impl_->context, 1, &source, &sourceLen, &err);
     if (err != CL_SUCCESS) throw std::runtime_error("Failed to create program");
     
-    err = clBuildProgram(impl_->program, 1, &impl_->device, nullptr, nullptr, nullptr);
+    const std::string options = "-DAES_ROUNDS=" + std::to_string(AesKeyTraits<KeyBits>::ROUNDS);
+    err = clBuildProgram(impl_->program, 1, &impl_->device, options.c_str(), nullptr, nullptr);
     if (err != CL_SUCCESS) {
         char log[8192];
         clGetProgramBuildInfo(impl_->program, impl_->device, CL_PROGRAM_BUILD_LOG, sizeof(log), log, nullptr);
@@ -203,7 +216,8 @@ void AesOpenCLEngine::initialize() {
 #endif
 }
 
-void AesOpenCLEngine::cleanup() {
+template <int KeyBits>
+void AesOpenCLEngine<KeyBits>::cleanup() {
 #ifdef HAS_OPENCL
     if (impl_->kernel) { clReleaseKernel(impl_->kernel); impl_->kernel = nullptr; }
     if (impl_->program) { clReleaseProgram(impl_->program); impl_->program = nullptr; }
@@ -213,35 +227,39 @@ void AesOpenCLEngine::cleanup() {
 #endif
 }
 
-void AesOpenCLEngine::encrypt(const uint8_t* input, uint8_t* output, 
-                               size_t size, const uint8_t* key, size_t keyLen,
-                               const uint8_t* iv) {
+template <int KeyBits>
+void AesOpenCLEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                        size_t size, const uint8_t* key, size_t keyLen,
+                                        const uint8_t* iv) {
 #ifdef HAS_OPENCL
-    if (keyLen != 32) throw std::runtime_error("AES-256 requires 32-byte key");
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
     if (!initialized_) initialize();
     
     const uint8_t* actualIV = iv ? iv : impl_->defaultIV.data();
     
-    uint32_t roundKeys[60];
-    aes::keyExpansion256(key, roundKeys);
+    PhaseScope phase(phases_, Phase::KeySchedule);
+    auto roundKeys = AesKeyTraits<KeyBits>::roundKeyWords(key);
     
+    phase.next(Phase::Setup);
     size_t paddedSize = ((size + 15) / 16) * 16;
     size_t numBlocks = paddedSize / 16;
     
     std::vector<uint8_t> paddedInput(paddedSize, 0);
     std::memcpy(paddedInput.data(), input, size);
     
+    phase.next(Phase::TransferIn);
     cl_int err;
     cl_mem inputBuf = clCreateBuffer(impl_->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
                                       paddedSize, paddedInput.data(), &err);
     cl_mem outputBuf = clCreateBuffer(impl_->context, CL_MEM_WRITE_ONLY, paddedSize, nullptr, &err);
     cl_mem keyBuf = clCreateBuffer(impl_->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                    sizeof(roundKeys), roundKeys, &err);
+                                    sizeof(*roundKeys), const_cast<uint32_t*>(roundKeys->data()), &err);
     cl_mem ivBuf = clCreateBuffer(impl_->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
                                    16, const_cast<uint8_t*>(actualIV), &err);
     
     cl_ulong numBlocksU = static_cast<cl_ulong>(numBlocks);
     
+    phase.next(Phase::Compute);
     clSetKernelArg(impl_->kernel, 0, sizeof(cl_mem), &inputBuf);
     clSetKernelArg(impl_->kernel, 1, sizeof(cl_mem), &outputBuf);
     clSetKernelArg(impl_->kernel, 2, sizeof(cl_mem), &keyBuf);
@@ -254,9 +272,12 @@ void AesOpenCLEngine::encrypt(const uint8_t* input, uint8_t* output,
     
     clEnqueueNDRangeKernel(impl_->queue, impl_->kernel, 1, nullptr, 
                             &globalSize, &localSize, 0, nullptr, nullptr);
+    clFinish(impl_->queue);
     
+    phase.next(Phase::TransferOut);
     clEnqueueReadBuffer(impl_->queue, outputBuf, CL_TRUE, 0, size, output, 0, nullptr, nullptr);
     
+    phase.next(Phase::Teardown);
     clReleaseMemObject(inputBuf);
     clReleaseMemObject(outputBuf);
     clReleaseMemObject(keyBuf);
@@ -266,10 +287,15 @@ void AesOpenCLEngine::encrypt(const uint8_t* input, uint8_t* output,
 #endif
 }
 
-void AesOpenCLEngine::decrypt(const uint8_t* input, uint8_t* output, 
-                               size_t size, const uint8_t* key, size_t keyLen,
-                               const uint8_t* iv) {
+template <int KeyBits>
+void AesOpenCLEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                        size_t size, const uint8_t* key, size_t keyLen,
+                                        const uint8_t* iv) {
     encrypt(input, output, size, key, keyLen, iv);
 }
 
+template class AesOpenCLEngine<128>;
+template class AesOpenCLEngine<192>;
+template class AesOpenCLEngine<256>;
+
 }
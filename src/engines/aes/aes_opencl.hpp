@@ -1,15 +1,19 @@
 #pragma once
 
 #include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
 
 namespace hpc_benchmark {
 
+// AES-CTR with one work-item per block; instantiated for 128, 192 and
+// 256-bit keys. The program is built with the round count as a constant.
+template <int KeyBits>
 class AesOpenCLEngine : public ICipherEngine {
 public:
     AesOpenCLEngine();
     ~AesOpenCLEngine() override;
     
-    std::string getAlgorithmName() const override { return "AES-256-CTR"; }
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("CTR"); }
     std::string getEngineName() const override { return "OpenCL"; }
     
     void encrypt(const uint8_t* input, uint8_t* output, 
@@ -24,6 +28,8 @@ public:
     void initialize() override;
     void cleanup() override;
     
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+
 private:
     struct Impl;
     Impl* impl_;
@@ -1,6 +1,9 @@
 #include "aes_openmp.hpp"
+#include "kernels/aes_tables.hpp"
 #include <openssl/evp.h>
 #include <openssl/rand.h>
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <cstring>
 #include <vector>
@@ -11,13 +14,70 @@
 
 namespace hpc_benchmark {
 
-AesOpenMPEngine::AesOpenMPEngine() {
+template <int KeyBits>
+AesOpenMPEngine<KeyBits>::AesOpenMPEngine(const EvpUsage& usage)
+    : usage_(usage), cipher_(evpCtrCipher(KeyBits, usage.fetch)) {
     RAND_bytes(defaultIV_.data(), 16);
 }
 
-AesOpenMPEngine::~AesOpenMPEngine() {}
+template <int KeyBits>
+AesOpenMPEngine<KeyBits>::~AesOpenMPEngine() {
+    for (EVP_CIPHER_CTX* ctx : threadContexts_) {
+        EVP_CIPHER_CTX_free(ctx);
+    }
+}
 
-bool AesOpenMPEngine::isAvailable() const {
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::prepareThreadContexts() {
+#ifdef HAS_OPENMP
+    if (usage_.context != EvpContext::Reset) return;
+    size_t threads = static_cast<size_t>(omp_get_max_threads());
+    while (threadContexts_.size() < threads) {
+        threadContexts_.push_back(EVP_CIPHER_CTX_new());
+    }
+#endif
+}
+
+template <int KeyBits>
+EVP_CIPHER_CTX* AesOpenMPEngine<KeyBits>::acquireContext() {
+#ifdef HAS_OPENMP
+    if (usage_.context == EvpContext::Reset) {
+        return threadContexts_[static_cast<size_t>(omp_get_thread_num())];
+    }
+#endif
+    return EVP_CIPHER_CTX_new();
+}
+
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::releaseContext(EVP_CIPHER_CTX* ctx) {
+    if (usage_.context != EvpContext::Reset) {
+        EVP_CIPHER_CTX_free(ctx);
+    }
+}
+
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::initialize() {
+    tuned_ = TuningCache::shared().entriesFor(getAlgorithmName(), getEngineName());
+}
+
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::setTuning(const OmpTuning& tuning) {
+    tuning_ = tuning;
+    tuningPinned_ = true;
+}
+
+template <int KeyBits>
+bool AesOpenMPEngine<KeyBits>::getTuning(size_t size, OmpTuning& tuning) const {
+    OmpTuning base = tuning_;
+    if (numThreads_ > 0) {
+        base.threads = numThreads_;
+    }
+    tuning = tuningPinned_ ? base : resolveTuning(tuned_, size, base);
+    return true;
+}
+
+template <int KeyBits>
+bool AesOpenMPEngine<KeyBits>::isAvailable() const {
 #ifdef HAS_OPENMP
     return true;
 #else
@@ -25,30 +85,40 @@ bool AesOpenMPEngine::isAvailable() const {
 #endif
 }
 
-void AesOpenMPEngine::encrypt(const uint8_t* input, uint8_t* output, 
-                               size_t size, const uint8_t* key, size_t keyLen,
-                               const uint8_t* iv) {
-    if (keyLen != 32) {
-        throw std::runtime_error("AES-256 requires 32-byte key");
-    }
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                        size_t size, const uint8_t* key, size_t keyLen,
+                                        const uint8_t* iv) {
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
     
     const uint8_t* actualIV = iv ? iv : defaultIV_.data();
     
 #ifdef HAS_OPENMP
-    if (numThreads_ > 0) {
-        omp_set_num_threads(numThreads_);
+    OmpTuning tuning;
+    getTuning(size, tuning);
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
     }
+    applyOmpSchedule(tuning.schedule);
     
     constexpr size_t BLOCK_SIZE = 16;
-    constexpr size_t CHUNK_SIZE = 1024 * 1024;
+    const size_t CHUNK_SIZE = std::max(BLOCK_SIZE, tuning.chunkBytes / BLOCK_SIZE * BLOCK_SIZE);
     
     size_t numChunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    prepareThreadContexts();
+    
+    std::atomic<bool> failed{false};
+    ParallelRegionTimer region(phases_);
     
     #pragma omp parallel
     {
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        EvpSetupTimer setup;
+        setup.begin();
+        EVP_CIPHER_CTX* ctx = acquireContext();
+        setup.pause();
+        region.threadReady();
         
-        #pragma omp for schedule(dynamic)
+        #pragma omp for schedule(runtime)
         for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
             size_t offset = chunkIdx * CHUNK_SIZE;
             size_t chunkLen = std::min(CHUNK_SIZE, size - offset);
@@ -56,38 +126,134 @@ void AesOpenMPEngine::encrypt(const uint8_t* input, uint8_t* output,
             std::array<uint8_t, 16> chunkIV;
             std::memcpy(chunkIV.data(), actualIV, 16);
             
-            uint64_t blockOffset = offset / BLOCK_SIZE;
-            for (int i = 15; i >= 8 && blockOffset > 0; --i) {
-                chunkIV[i] = (chunkIV[i] + (blockOffset & 0xff)) & 0xff;
-                blockOffset >>= 8;
-            }
+            aes::addCounter(chunkIV.data(), offset / BLOCK_SIZE);
             
+            setup.begin();
             EVP_CIPHER_CTX_reset(ctx);
-            EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, key, chunkIV.data());
+            bool ok = AesKeyTraits<KeyBits>::initCtr(ctx, cipher_, key, chunkIV.data());
+            setup.end();
             
             int outLen = 0;
-            EVP_EncryptUpdate(ctx, output + offset, &outLen, input + offset, static_cast<int>(chunkLen));
-            EVP_EncryptFinal_ex(ctx, output + offset + outLen, &outLen);
+            ok = ok && EVP_EncryptUpdate(ctx, output + offset, &outLen, input + offset,
+                                         static_cast<int>(chunkLen)) == 1;
+            ok = ok && EVP_EncryptFinal_ex(ctx, output + offset + outLen, &outLen) == 1;
+            if (!ok) {
+                failed = true;
+            }
         }
         
-        EVP_CIPHER_CTX_free(ctx);
+        #pragma omp master
+        region.workDone();
+        
+        releaseContext(ctx);
+    }
+    
+    region.finish();
+    
+    if (failed) {
+        throw std::runtime_error(getAlgorithmName() + " encryption failed");
     }
 #else
+    PhaseScope phase(phases_, Phase::Setup);
     EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, key, actualIV);
+    phase.next(Phase::KeySchedule);
+    EVP_EncryptInit_ex(ctx, cipher_, nullptr, key, actualIV);
     
+    phase.next(Phase::Compute);
     int outLen = 0;
     EVP_EncryptUpdate(ctx, output, &outLen, input, static_cast<int>(size));
     EVP_EncryptFinal_ex(ctx, output + outLen, &outLen);
     
+    phase.next(Phase::Teardown);
     EVP_CIPHER_CTX_free(ctx);
 #endif
 }
 
-void AesOpenMPEngine::decrypt(const uint8_t* input, uint8_t* output, 
-                               size_t size, const uint8_t* key, size_t keyLen,
-                               const uint8_t* iv) {
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::encryptBatch(const CipherJob* jobs, size_t count) {
+    size_t totalBytes = 0;
+    for (size_t j = 0; j < count; ++j) {
+        AesKeyTraits<KeyBits>::checkKey(jobs[j].keyLen);
+        totalBytes += jobs[j].size;
+    }
+    
+#ifdef HAS_OPENMP
+    OmpTuning tuning;
+    getTuning(totalBytes, tuning);
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
+    }
+    applyOmpSchedule(tuning.schedule);
+    
+    constexpr size_t BLOCK_SIZE = 16;
+    const size_t CHUNK_SIZE = std::max(BLOCK_SIZE, tuning.chunkBytes / BLOCK_SIZE * BLOCK_SIZE);
+    const std::vector<CipherJobChunk> chunks = splitJobs(jobs, count, CHUNK_SIZE);
+    prepareThreadContexts();
+    
+    std::atomic<bool> failed{false};
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel
+    {
+        EvpSetupTimer setup;
+        setup.begin();
+        EVP_CIPHER_CTX* ctx = acquireContext();
+        if (usage_.context == EvpContext::Reset) EVP_CIPHER_CTX_reset(ctx);
+        setup.pause();
+        const uint8_t* scheduledKey = nullptr;
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const CipherJob& job = jobs[chunks[c].job];
+            
+            std::array<uint8_t, 16> chunkIV;
+            std::memcpy(chunkIV.data(), job.iv ? job.iv : defaultIV_.data(), 16);
+            aes::addCounter(chunkIV.data(), chunks[c].offset / BLOCK_SIZE);
+            
+            bool ok = true;
+            if (job.key != scheduledKey) {
+                setup.begin();
+                ok = AesKeyTraits<KeyBits>::initCtr(ctx, cipher_, job.key, chunkIV.data());
+                setup.end();
+                scheduledKey = ok ? job.key : nullptr;
+            } else {
+                ok = EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, chunkIV.data()) == 1;
+            }
+            
+            int outLen = 0;
+            ok = ok && EVP_EncryptUpdate(ctx, job.output + chunks[c].offset, &outLen,
+                                         job.input + chunks[c].offset, static_cast<int>(chunks[c].size)) == 1;
+            if (!ok) {
+                failed = true;
+            }
+        }
+        
+        #pragma omp master
+        region.workDone();
+        
+        releaseContext(ctx);
+    }
+    
+    region.finish();
+    
+    if (failed) {
+        throw std::runtime_error(getAlgorithmName() + " batch encryption failed");
+    }
+#else
+    ICipherEngine::encryptBatch(jobs, count);
+#endif
+}
+
+template <int KeyBits>
+void AesOpenMPEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                        size_t size, const uint8_t* key, size_t keyLen,
+                                        const uint8_t* iv) {
     encrypt(input, output, size, key, keyLen, iv);
 }
 
+template class AesOpenMPEngine<128>;
+template class AesOpenMPEngine<192>;
+template class AesOpenMPEngine<256>;
+
 }
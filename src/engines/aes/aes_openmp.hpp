@@ -1,15 +1,22 @@
 #pragma once
 
 #include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
+#include "engines/aes/evp_usage.hpp"
+#include <array>
+#include <vector>
 
 namespace hpc_benchmark {
 
+// Chunked AES-CTR across OpenMP threads; instantiated for 128, 192 and
+// 256-bit keys. By default each thread creates a context per call.
+template <int KeyBits>
 class AesOpenMPEngine : public ICipherEngine {
 public:
-    AesOpenMPEngine();
+    explicit AesOpenMPEngine(const EvpUsage& usage = defaultEvpUsage(EvpContext::Fresh));
     ~AesOpenMPEngine() override;
     
-    std::string getAlgorithmName() const override { return "AES-256-CTR"; }
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("CTR"); }
     std::string getEngineName() const override { return "OpenMP"; }
     
     void encrypt(const uint8_t* input, uint8_t* output, 
@@ -20,13 +27,46 @@ public:
                 size_t size, const uint8_t* key, size_t keyLen,
                 const uint8_t* iv = nullptr) override;
     
+    // One parallel region over the chunks of every job; a thread redoes
+    // the key schedule only when its next chunk has a different key.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
+    void prepareKey(const uint8_t* key, size_t keyLen) override {
+        if (keyLen == AesKeyTraits<KeyBits>::KEY_BYTES) AesKeyTraits<KeyBits>::prepareCtr(cipher_, key);
+    }
+    
     bool isAvailable() const override;
+    void initialize() override;
+    
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+    
+    void setNumThreads(int threads) override { numThreads_ = threads; }
     
-    void setNumThreads(int threads) { numThreads_ = threads; }
+    // Pins the schedule and chunk size, bypassing the tuning cache.
+    void setTuning(const OmpTuning& tuning) override;
+    bool getTuning(size_t size, OmpTuning& tuning) const override;
     
+    const EvpUsage& getEvpUsage() const { return usage_; }
+
 private:
+    // With EvpContext::Reset, makes sure every thread of the next region
+    // has a context of its own.
+    void prepareThreadContexts();
+    EVP_CIPHER_CTX* acquireContext();
+    void releaseContext(EVP_CIPHER_CTX* ctx);
+    
+    EvpUsage usage_;
+    const EVP_CIPHER* cipher_;
+    std::vector<EVP_CIPHER_CTX*> threadContexts_;
     int numThreads_ = 0;
+    OmpTuning tuning_{0, OmpSchedule::Dynamic, 1024 * 1024};
+    bool tuningPinned_ = false;
+    std::vector<TuningEntry> tuned_;
     std::array<uint8_t, 16> defaultIV_;
 };
 
+extern template class AesOpenMPEngine<128>;
+extern template class AesOpenMPEngine<192>;
+extern template class AesOpenMPEngine<256>;
+
 }
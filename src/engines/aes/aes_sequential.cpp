@@ -7,11 +7,14 @@
 
 namespace hpc_benchmark {
 
-struct AesSequentialEngine::Impl {
+template <int KeyBits>
+struct AesSequentialEngine<KeyBits>::Impl {
+    EvpUsage usage;
+    const EVP_CIPHER* cipher;
     EVP_CIPHER_CTX* ctx = nullptr;
     std::array<uint8_t, 16> defaultIV;
     
-    Impl() {
+    explicit Impl(const EvpUsage& u) : usage(u), cipher(evpCtrCipher(KeyBits, u.fetch)) {
         ctx = EVP_CIPHER_CTX_new();
         RAND_bytes(defaultIV.data(), 16);
     }
@@ -21,53 +24,136 @@ struct AesSequentialEngine::Impl {
     }
 };
 
-AesSequentialEngine::AesSequentialEngine() : impl_(new Impl()) {}
+// The context one call works in: the engine's own after a reset, or a new
+// one freed when the call returns.
+template <int KeyBits>
+class AesSequentialEngine<KeyBits>::CallContext {
+public:
+    explicit CallContext(Impl& impl)
+        : ctx_(impl.usage.context == EvpContext::Reset ? impl.ctx : EVP_CIPHER_CTX_new()),
+          owned_(ctx_ != impl.ctx) {
+        if (!owned_) EVP_CIPHER_CTX_reset(ctx_);
+    }
+    ~CallContext() {
+        if (owned_) EVP_CIPHER_CTX_free(ctx_);
+    }
+    EVP_CIPHER_CTX* get() const { return ctx_; }
+
+private:
+    EVP_CIPHER_CTX* ctx_;
+    bool owned_;
+};
 
-AesSequentialEngine::~AesSequentialEngine() {
+template <int KeyBits>
+AesSequentialEngine<KeyBits>::AesSequentialEngine(const EvpUsage& usage) : impl_(new Impl(usage)) {}
+
+template <int KeyBits>
+AesSequentialEngine<KeyBits>::~AesSequentialEngine() {
     cleanup();
     delete impl_;
 }
 
-bool AesSequentialEngine::isAvailable() const {
+template <int KeyBits>
+bool AesSequentialEngine<KeyBits>::isAvailable() const {
     return true;
 }
 
-void AesSequentialEngine::initialize() {}
+template <int KeyBits>
+const EvpUsage& AesSequentialEngine<KeyBits>::getEvpUsage() const {
+    return impl_->usage;
+}
+
+template <int KeyBits>
+void AesSequentialEngine<KeyBits>::initialize() {}
 
-void AesSequentialEngine::cleanup() {}
+template <int KeyBits>
+void AesSequentialEngine<KeyBits>::cleanup() {}
 
-void AesSequentialEngine::encrypt(const uint8_t* input, uint8_t* output, 
-                                   size_t size, const uint8_t* key, size_t keyLen,
-                                   const uint8_t* iv) {
-    if (keyLen != 32) {
-        throw std::runtime_error("AES-256 requires 32-byte key");
-    }
+template <int KeyBits>
+void AesSequentialEngine<KeyBits>::prepareKey(const uint8_t* key, size_t keyLen) {
+    if (keyLen == AesKeyTraits<KeyBits>::KEY_BYTES) AesKeyTraits<KeyBits>::prepareCtr(impl_->cipher, key);
+}
+
+template <int KeyBits>
+void AesSequentialEngine<KeyBits>::encrypt(const uint8_t* input, uint8_t* output, 
+                                            size_t size, const uint8_t* key, size_t keyLen,
+                                            const uint8_t* iv) {
+    AesKeyTraits<KeyBits>::checkKey(keyLen);
     
     const uint8_t* actualIV = iv ? iv : impl_->defaultIV.data();
     
-    EVP_CIPHER_CTX_reset(impl_->ctx);
+    EvpSetupTimer setup;
+    setup.begin();
+    PhaseScope phase(phases_, Phase::Setup);
+    CallContext ctx(*impl_);
     
-    if (EVP_EncryptInit_ex(impl_->ctx, EVP_aes_256_ctr(), nullptr, key, actualIV) != 1) {
+    phase.next(Phase::KeySchedule);
+    if (!AesKeyTraits<KeyBits>::initCtr(ctx.get(), impl_->cipher, key, actualIV)) {
         throw std::runtime_error("EVP_EncryptInit_ex failed");
     }
+    setup.end();
     
+    phase.next(Phase::Compute);
     int outLen = 0;
     int totalLen = 0;
     
-    if (EVP_EncryptUpdate(impl_->ctx, output, &outLen, input, static_cast<int>(size)) != 1) {
+    if (EVP_EncryptUpdate(ctx.get(), output, &outLen, input, static_cast<int>(size)) != 1) {
         throw std::runtime_error("EVP_EncryptUpdate failed");
     }
     totalLen = outLen;
     
-    if (EVP_EncryptFinal_ex(impl_->ctx, output + totalLen, &outLen) != 1) {
+    if (EVP_EncryptFinal_ex(ctx.get(), output + totalLen, &outLen) != 1) {
         throw std::runtime_error("EVP_EncryptFinal_ex failed");
     }
 }
 
-void AesSequentialEngine::decrypt(const uint8_t* input, uint8_t* output, 
-                                   size_t size, const uint8_t* key, size_t keyLen,
-                                   const uint8_t* iv) {
+template <int KeyBits>
+void AesSequentialEngine<KeyBits>::encryptBatch(const CipherJob* jobs, size_t count) {
+    EvpSetupTimer setup;
+    setup.begin();
+    PhaseScope phase(phases_, Phase::Setup);
+    CallContext ctx(*impl_);
+    setup.pause();
+    
+    phase.next(Phase::Compute);
+    const uint8_t* scheduledKey = nullptr;
+    for (size_t j = 0; j < count; ++j) {
+        const CipherJob& job = jobs[j];
+        AesKeyTraits<KeyBits>::checkKey(job.keyLen);
+        const uint8_t* actualIV = job.iv ? job.iv : impl_->defaultIV.data();
+        
+        bool sameKey = scheduledKey &&
+                       (job.key == scheduledKey ||
+                        std::memcmp(job.key, scheduledKey, AesKeyTraits<KeyBits>::KEY_BYTES) == 0);
+        bool ok = true;
+        if (sameKey) {
+            ok = EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr, nullptr, actualIV) == 1;
+        } else {
+            setup.begin();
+            ok = AesKeyTraits<KeyBits>::initCtr(ctx.get(), impl_->cipher, job.key, actualIV);
+            setup.end();
+        }
+        if (!ok) {
+            throw std::runtime_error("EVP_EncryptInit_ex failed");
+        }
+        scheduledKey = job.key;
+        
+        int outLen = 0;
+        if (EVP_EncryptUpdate(ctx.get(), job.output, &outLen, job.input, static_cast<int>(job.size)) != 1) {
+            throw std::runtime_error("EVP_EncryptUpdate failed");
+        }
+    }
+}
+
+template <int KeyBits>
+void AesSequentialEngine<KeyBits>::decrypt(const uint8_t* input, uint8_t* output, 
+                                            size_t size, const uint8_t* key, size_t keyLen,
+                                            const uint8_t* iv) {
     encrypt(input, output, size, key, keyLen, iv);
 }
 
+template class AesSequentialEngine<128>;
+template class AesSequentialEngine<192>;
+template class AesSequentialEngine<256>;
+
 }
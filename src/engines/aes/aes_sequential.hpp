@@ -1,15 +1,20 @@
 #pragma once
 
 #include "engines/i_cipher_engine.hpp"
+#include "engines/aes/aes_key_size.hpp"
+#include "engines/aes/evp_usage.hpp"
 
 namespace hpc_benchmark {
 
+// AES-CTR through EVP; instantiated for 128, 192 and 256-bit keys. By
+// default one context is reset and re-keyed per call.
+template <int KeyBits>
 class AesSequentialEngine : public ICipherEngine {
 public:
-    AesSequentialEngine();
+    explicit AesSequentialEngine(const EvpUsage& usage = defaultEvpUsage(EvpContext::Reset));
     ~AesSequentialEngine() override;
     
-    std::string getAlgorithmName() const override { return "AES-256-CTR"; }
+    std::string getAlgorithmName() const override { return AesKeyTraits<KeyBits>::algorithmName("CTR"); }
     std::string getEngineName() const override { return "Sequential"; }
     
     void encrypt(const uint8_t* input, uint8_t* output, 
@@ -20,13 +25,27 @@ public:
                 size_t size, const uint8_t* key, size_t keyLen,
                 const uint8_t* iv = nullptr) override;
     
+    // Keeps the key schedule across consecutive jobs with the same key.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
+    void prepareKey(const uint8_t* key, size_t keyLen) override;
+    
     bool isAvailable() const override;
     void initialize() override;
     void cleanup() override;
     
+    size_t getKeyBytes() const override { return AesKeyTraits<KeyBits>::KEY_BYTES; }
+    
+    const EvpUsage& getEvpUsage() const;
+
 private:
     struct Impl;
+    class CallContext;
     Impl* impl_;
 };
 
+extern template class AesSequentialEngine<128>;
+extern template class AesSequentialEngine<192>;
+extern template class AesSequentialEngine<256>;
+
 }
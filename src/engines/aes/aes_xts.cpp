@@ -0,0 +1,195 @@
+#include "aes_xts.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+constexpr size_t XTS_BLOCK_BYTES = 16;
+// OpenSSL 3 rejects XTS data units longer than 2^20 blocks.
+constexpr size_t XTS_MAX_SECTOR_BYTES = XTS_BLOCK_BYTES << 20;
+
+size_t& sharedSectorBytes() {
+    static size_t bytes = 4096;
+    return bytes;
+}
+
+void checkSectorBytes(size_t bytes) {
+    if (bytes < XTS_BLOCK_BYTES) {
+        throw std::runtime_error("AES-XTS sector size must be at least 16 bytes");
+    }
+    if (bytes > XTS_MAX_SECTOR_BYTES) {
+        throw std::runtime_error("AES-XTS sector size must be at most 16 MiB (2^20 blocks)");
+    }
+}
+
+// 128-bit little-endian tweak + index.
+std::array<uint8_t, 16> sectorTweak(const uint8_t* base, uint64_t index) {
+    std::array<uint8_t, 16> tweak;
+    unsigned carry = 0;
+    for (int i = 0; i < 16; ++i) {
+        unsigned sum = base[i] + static_cast<unsigned>(index & 0xff) + carry;
+        tweak[i] = static_cast<uint8_t>(sum);
+        carry = sum >> 8;
+        index >>= 8;
+    }
+    return tweak;
+}
+
+}
+
+size_t AesXtsEngine::defaultSectorBytes() {
+    return sharedSectorBytes();
+}
+
+void AesXtsEngine::setDefaultSectorBytes(size_t bytes) {
+    checkSectorBytes(bytes);
+    sharedSectorBytes() = bytes;
+}
+
+AesXtsEngine::AesXtsEngine(bool parallel) : parallel_(parallel), sectorBytes_(defaultSectorBytes()) {
+    RAND_bytes(defaultIV_.data(), 16);
+}
+
+AesXtsEngine::~AesXtsEngine() {}
+
+bool AesXtsEngine::isAvailable() const {
+#ifdef HAS_OPENMP
+    return true;
+#else
+    return !parallel_;
+#endif
+}
+
+void AesXtsEngine::initialize() {
+    if (parallel_) {
+        tuned_ = TuningCache::shared().entriesFor(getAlgorithmName(), getEngineName());
+    }
+}
+
+void AesXtsEngine::setTuning(const OmpTuning& tuning) {
+    tuning_ = tuning;
+    tuningPinned_ = true;
+}
+
+bool AesXtsEngine::getTuning(size_t size, OmpTuning& tuning) const {
+    if (!parallel_) return false;
+    OmpTuning base = tuning_;
+    if (numThreads_ > 0) {
+        base.threads = numThreads_;
+    }
+    tuning = tuningPinned_ ? base : resolveTuning(tuned_, size, base);
+    return true;
+}
+
+void AesXtsEngine::setSectorBytes(size_t bytes) {
+    checkSectorBytes(bytes);
+    sectorBytes_ = bytes;
+}
+
+void AesXtsEngine::encrypt(const uint8_t* input, uint8_t* output,
+                           size_t size, const uint8_t* key, size_t keyLen,
+                           const uint8_t* iv) {
+    CipherJob job{input, output, size, key, keyLen, iv};
+    run(true, &job, 1);
+}
+
+void AesXtsEngine::decrypt(const uint8_t* input, uint8_t* output,
+                           size_t size, const uint8_t* key, size_t keyLen,
+                           const uint8_t* iv) {
+    CipherJob job{input, output, size, key, keyLen, iv};
+    run(false, &job, 1);
+}
+
+void AesXtsEngine::encryptBatch(const CipherJob* jobs, size_t count) {
+    run(true, jobs, count);
+}
+
+void AesXtsEngine::run(bool encrypting, const CipherJob* jobs, size_t count) {
+    const size_t sector = sectorBytes_;
+    for (size_t j = 0; j < count; ++j) {
+        if (jobs[j].keyLen != KEY_BYTES) {
+            throw std::runtime_error("AES-256-XTS requires 64-byte key");
+        }
+        if (jobs[j].size % sector != 0 && jobs[j].size % sector < XTS_BLOCK_BYTES) {
+            throw std::runtime_error("AES-256-XTS: trailing partial sector shorter than 16 bytes");
+        }
+    }
+    
+    // Sector s of a job is chunk offset / sector; its tweak is iv + s.
+    const std::vector<CipherJobChunk> sectors = splitJobs(jobs, count, sector);
+    std::atomic<bool> failed{false};
+    
+    size_t totalBytes = 0;
+    for (size_t j = 0; j < count; ++j) {
+        totalBytes += jobs[j].size;
+    }
+    size_t perItem = 1;
+    OmpTuning tuning;
+    if (getTuning(totalBytes, tuning)) {
+#ifdef HAS_OPENMP
+        if (tuning.threads > 0) {
+            omp_set_num_threads(tuning.threads);
+        }
+        applyOmpSchedule(tuning.schedule);
+#endif
+        perItem = std::max<size_t>(1, tuning.chunkBytes / sector);
+    }
+    const size_t numItems = (sectors.size() + perItem - 1) / perItem;
+    
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel if (parallel_)
+    {
+        // Both key schedules are expanded once per thread and key; each
+        // sector only re-inits the tweak.
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        const uint8_t* scheduledKey = nullptr;
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t item = 0; item < numItems; ++item) {
+            const size_t last = std::min(sectors.size(), (item + 1) * perItem);
+            for (size_t s = item * perItem; s < last; ++s) {
+                const CipherJob& job = jobs[sectors[s].job];
+                if (job.key != scheduledKey) {
+                    if (EVP_CipherInit_ex(ctx, EVP_aes_256_xts(), nullptr, job.key, nullptr, encrypting ? 1 : 0) != 1) {
+                        failed = true;
+                    }
+                    scheduledKey = job.key;
+                }
+                
+                std::array<uint8_t, 16> tweak = sectorTweak(job.iv ? job.iv : defaultIV_.data(),
+                                                            sectors[s].offset / sector);
+                int outLen = 0;
+                bool ok = EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, tweak.data(), -1) == 1 &&
+                          EVP_CipherUpdate(ctx, job.output + sectors[s].offset, &outLen,
+                                           job.input + sectors[s].offset, static_cast<int>(sectors[s].size)) == 1;
+                if (!ok) failed = true;
+            }
+        }
+        
+        #pragma omp master
+        region.workDone();
+        
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    region.finish();
+    
+    if (failed) {
+        throw std::runtime_error(encrypting ? "AES-256-XTS sector encryption failed"
+                                            : "AES-256-XTS sector decryption failed");
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <array>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// AES-256-XTS (IEEE 1619) over a run of fixed-size sectors, as a block
+// device encrypts them. Sector i of a call uses tweak iv + i (128-bit
+// little-endian data unit number), so a call at device sector n passes n
+// as the iv. A trailing partial sector of at least 16 bytes is handled by
+// ciphertext stealing. Sectors are independent, so the parallel variant
+// spreads them over threads, chunkBytes worth of sectors per work item.
+class AesXtsEngine : public ICipherEngine {
+public:
+    static constexpr size_t KEY_BYTES = 64;  // data key || tweak key
+    
+    // parallel = false processes the same sectors on the calling thread.
+    explicit AesXtsEngine(bool parallel = true);
+    ~AesXtsEngine() override;
+    
+    std::string getAlgorithmName() const override { return "AES-256-XTS"; }
+    std::string getEngineName() const override { return parallel_ ? "OpenMP" : "Sequential"; }
+    
+    void encrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    void decrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    // The sectors of every job share one (parallel) loop.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
+    bool isAvailable() const override;
+    void initialize() override;
+    
+    void setNumThreads(int threads) override { numThreads_ = threads; }
+    size_t getKeyBytes() const override { return KEY_BYTES; }
+    
+    // OpenMP variant only: schedule and sectors per work item
+    // (chunkBytes / sector size, at least one); pinning bypasses the
+    // tuning cache.
+    void setTuning(const OmpTuning& tuning) override;
+    bool getTuning(size_t size, OmpTuning& tuning) const override;
+    
+    size_t getSectorBytes() const { return sectorBytes_; }
+    void setSectorBytes(size_t bytes);
+    
+    // Sector size of newly constructed engines (--sector-size); 4096 unless
+    // changed.
+    static size_t defaultSectorBytes();
+    static void setDefaultSectorBytes(size_t bytes);
+
+private:
+    void run(bool encrypting, const CipherJob* jobs, size_t count);
+    
+    bool parallel_;
+    int numThreads_ = 0;
+    OmpTuning tuning_{0, OmpSchedule::Static, 0};  // chunkBytes 0: one sector per item
+    bool tuningPinned_ = false;
+    std::vector<TuningEntry> tuned_;
+    size_t sectorBytes_;
+    std::array<uint8_t, 16> defaultIV_;
+};
+
+}
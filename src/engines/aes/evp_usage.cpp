@@ -0,0 +1,180 @@
+#include "evp_usage.hpp"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/provider.h>
+#define HAS_EVP_FETCH 1
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+struct DefaultUsage {
+    EvpFetch fetch = EvpFetch::Implicit;
+    std::optional<EvpContext> context;
+};
+
+DefaultUsage& defaults() {
+    static DefaultUsage usage;
+    return usage;
+}
+
+const char* ctrName(int keyBits) {
+    switch (keyBits) {
+        case 128: return "AES-128-CTR";
+        case 192: return "AES-192-CTR";
+        case 256: return "AES-256-CTR";
+    }
+    throw std::runtime_error("Unsupported AES key size: " + std::to_string(keyBits));
+}
+
+const EVP_CIPHER* implicitCtr(int keyBits) {
+    switch (keyBits) {
+        case 128: return EVP_aes_128_ctr();
+        case 192: return EVP_aes_192_ctr();
+        case 256: return EVP_aes_256_ctr();
+    }
+    throw std::runtime_error("Unsupported AES key size: " + std::to_string(keyBits));
+}
+
+#ifdef HAS_EVP_FETCH
+
+// A library context with the default provider loaded, alive until exit.
+OSSL_LIB_CTX* ownLibCtx() {
+    static OSSL_LIB_CTX* libctx = [] {
+        OSSL_LIB_CTX* ctx = OSSL_LIB_CTX_new();
+        if (!ctx || !OSSL_PROVIDER_load(ctx, "default")) {
+            throw std::runtime_error("Cannot create OpenSSL library context");
+        }
+        return ctx;
+    }();
+    return libctx;
+}
+
+// One fetched cipher per (library context, key size).
+const EVP_CIPHER* fetchedCtr(int keyBits, bool ownContext) {
+    static std::mutex mutex;
+    static EVP_CIPHER* ciphers[2][3] = {};
+    const int slot = keyBits == 128 ? 0 : keyBits == 192 ? 1 : 2;
+    std::lock_guard<std::mutex> lock(mutex);
+    EVP_CIPHER*& cipher = ciphers[ownContext ? 1 : 0][slot];
+    if (!cipher) {
+        cipher = EVP_CIPHER_fetch(ownContext ? ownLibCtx() : nullptr, ctrName(keyBits), nullptr);
+        if (!cipher) {
+            throw std::runtime_error(std::string("EVP_CIPHER_fetch failed for ") + ctrName(keyBits));
+        }
+    }
+    return cipher;
+}
+
+#endif
+
+std::atomic<bool> setupTiming{false};
+std::mutex setupMutex;
+EvpSetupStats setupStats;
+
+}
+
+const char* evpFetchName(EvpFetch fetch) {
+    switch (fetch) {
+        case EvpFetch::Implicit: return "implicit";
+        case EvpFetch::Process: return "process";
+        case EvpFetch::LibCtx: return "libctx";
+    }
+    return "unknown";
+}
+
+const char* evpContextName(EvpContext context) {
+    switch (context) {
+        case EvpContext::Fresh: return "fresh";
+        case EvpContext::Reset: return "reset";
+    }
+    return "unknown";
+}
+
+std::string evpUsageName(const EvpUsage& usage) {
+    return std::string(evpFetchName(usage.fetch)) + "/" + evpContextName(usage.context);
+}
+
+bool parseEvpUsage(const std::string& text, EvpFetch& fetch, std::optional<EvpContext>& context) {
+    size_t slash = text.find('/');
+    std::string fetchText = text.substr(0, slash);
+    if (fetchText == "implicit") fetch = EvpFetch::Implicit;
+    else if (fetchText == "process") fetch = EvpFetch::Process;
+    else if (fetchText == "libctx") fetch = EvpFetch::LibCtx;
+    else return false;
+    
+    context.reset();
+    if (slash != std::string::npos) {
+        std::string contextText = text.substr(slash + 1);
+        if (contextText == "fresh") context = EvpContext::Fresh;
+        else if (contextText == "reset") context = EvpContext::Reset;
+        else return false;
+    }
+    return true;
+}
+
+bool evpFetchAvailable(EvpFetch fetch) {
+#ifdef HAS_EVP_FETCH
+    (void)fetch;
+    return true;
+#else
+    return fetch == EvpFetch::Implicit;
+#endif
+}
+
+const EVP_CIPHER* evpCtrCipher(int keyBits, EvpFetch fetch) {
+    switch (fetch) {
+        case EvpFetch::Implicit:
+            return implicitCtr(keyBits);
+#ifdef HAS_EVP_FETCH
+        case EvpFetch::Process:
+            return fetchedCtr(keyBits, false);
+        case EvpFetch::LibCtx:
+            return fetchedCtr(keyBits, true);
+#else
+        case EvpFetch::Process:
+        case EvpFetch::LibCtx:
+            throw std::runtime_error("EVP_CIPHER_fetch needs OpenSSL 3");
+#endif
+    }
+    return implicitCtr(keyBits);
+}
+
+void setDefaultEvpUsage(EvpFetch fetch, std::optional<EvpContext> context) {
+    if (!evpFetchAvailable(fetch)) {
+        throw std::runtime_error(std::string("EVP fetch not available with this OpenSSL: ") + evpFetchName(fetch));
+    }
+    defaults().fetch = fetch;
+    defaults().context = context;
+}
+
+EvpUsage defaultEvpUsage(EvpContext engineDefault) {
+    return EvpUsage{defaults().fetch, defaults().context.value_or(engineDefault)};
+}
+
+void setEvpSetupTiming(bool enabled) {
+    setupTiming = enabled;
+}
+
+bool evpSetupTiming() {
+    return setupTiming.load(std::memory_order_relaxed);
+}
+
+void addEvpSetup(uint64_t inits, double seconds) {
+    std::lock_guard<std::mutex> lock(setupMutex);
+    setupStats.inits += inits;
+    setupStats.seconds += seconds;
+}
+
+EvpSetupStats takeEvpSetupStats() {
+    std::lock_guard<std::mutex> lock(setupMutex);
+    EvpSetupStats stats = setupStats;
+    setupStats = EvpSetupStats{};
+    return stats;
+}
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <openssl/evp.h>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace hpc_benchmark {
+
+// Where the AES-CTR EVP engines get their EVP_CIPHER. On OpenSSL 3,
+// EVP_aes_256_ctr() is a legacy handle that every EVP_EncryptInit_ex with
+// a cipher resolves again through a provider fetch, a lookup in a shared
+// method store taken under a lock. A fetched cipher skips that lookup.
+enum class EvpFetch {
+    Implicit,  // EVP_aes_*_ctr() on every init (OpenSSL's classic path)
+    Process,   // EVP_CIPHER_fetch once per process, default library context
+    LibCtx     // EVP_CIPHER_fetch once in a library context of our own
+};
+
+// How the engines get their EVP_CIPHER_CTX.
+enum class EvpContext {
+    Fresh,  // EVP_CIPHER_CTX_new/free per call (per thread and call for OpenMP)
+    Reset   // one long-lived context per thread, EVP_CIPHER_CTX_reset before reuse
+};
+
+struct EvpUsage {
+    EvpFetch fetch = EvpFetch::Implicit;
+    EvpContext context = EvpContext::Fresh;
+};
+
+const char* evpFetchName(EvpFetch fetch);
+const char* evpContextName(EvpContext context);
+// "process/reset", ...
+std::string evpUsageName(const EvpUsage& usage);
+
+// Parses "<fetch>" or "<fetch>/<context>", e.g. "libctx" or "implicit/reset".
+bool parseEvpUsage(const std::string& text, EvpFetch& fetch, std::optional<EvpContext>& context);
+
+// Explicit fetches need OpenSSL 3.
+bool evpFetchAvailable(EvpFetch fetch);
+
+// AES-CTR cipher for keyBits (128, 192, 256). Fetched ciphers are fetched
+// on first use and kept until exit.
+const EVP_CIPHER* evpCtrCipher(int keyBits, EvpFetch fetch);
+
+// Usage of engines constructed without one (--evp-usage). Without a
+// context override each engine keeps its own default.
+void setDefaultEvpUsage(EvpFetch fetch, std::optional<EvpContext> context);
+EvpUsage defaultEvpUsage(EvpContext engineDefault);
+
+// Time the engines spend getting a context ready for a key: new or reset
+// plus EVP_EncryptInit_ex. Summed over threads; off unless enabled. Each
+// thread adds its total once per call, so timing adds no shared writes to
+// the init path itself.
+struct EvpSetupStats {
+    uint64_t inits = 0;
+    double seconds = 0;
+    
+    double nsPerInit() const { return inits ? seconds * 1e9 / inits : 0; }
+};
+
+void setEvpSetupTiming(bool enabled);
+bool evpSetupTiming();
+void addEvpSetup(uint64_t inits, double seconds);
+// Returns the totals since the last call and clears them.
+EvpSetupStats takeEvpSetupStats();
+
+// One thread's setups within one call, reported when it goes out of scope.
+class EvpSetupTimer {
+public:
+    EvpSetupTimer() : enabled_(evpSetupTiming()) {}
+    ~EvpSetupTimer() {
+        if (enabled_ && inits_ > 0) addEvpSetup(inits_, seconds_);
+    }
+    
+    void begin() {
+        if (enabled_) start_ = std::chrono::steady_clock::now();
+    }
+    
+    void end() {
+        if (!enabled_) return;
+        seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        ++inits_;
+    }
+    
+    // Like end(), but the span is part of the next init, e.g. allocating
+    // the context it will use.
+    void pause() {
+        if (!enabled_) return;
+        seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    bool enabled_;
+    uint64_t inits_ = 0;
+    double seconds_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}
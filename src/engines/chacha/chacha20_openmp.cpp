@@ -0,0 +1,151 @@
+#include "chacha20_openmp.hpp"
+#include "kernels/chacha20.hpp"
+#include <openssl/rand.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc_benchmark {
+
+ChaCha20OpenMPEngine::ChaCha20OpenMPEngine() {
+    RAND_bytes(defaultIV_.data(), 16);
+}
+
+void ChaCha20OpenMPEngine::initialize() {
+    tuned_ = TuningCache::shared().entriesFor(getAlgorithmName(), getEngineName());
+}
+
+void ChaCha20OpenMPEngine::setTuning(const OmpTuning& tuning) {
+    tuning_ = tuning;
+    tuningPinned_ = true;
+}
+
+bool ChaCha20OpenMPEngine::getTuning(size_t size, OmpTuning& tuning) const {
+    OmpTuning base = tuning_;
+    if (numThreads_ > 0) {
+        base.threads = numThreads_;
+    }
+    tuning = tuningPinned_ ? base : resolveTuning(tuned_, size, base);
+    return true;
+}
+
+bool ChaCha20OpenMPEngine::isAvailable() const {
+#ifdef HAS_OPENMP
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ChaCha20OpenMPEngine::encrypt(const uint8_t* input, uint8_t* output, 
+                                   size_t size, const uint8_t* key, size_t keyLen,
+                                   const uint8_t* iv) {
+    if (keyLen != 32) {
+        throw std::runtime_error("ChaCha20 requires 32-byte key");
+    }
+    
+    const uint8_t* actualIV = iv ? iv : defaultIV_.data();
+    
+#ifdef HAS_OPENMP
+    OmpTuning tuning;
+    getTuning(size, tuning);
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
+    }
+    applyOmpSchedule(tuning.schedule);
+    
+    const size_t CHUNK_SIZE = std::max(chacha::BLOCK_BYTES,
+                                       tuning.chunkBytes / chacha::BLOCK_BYTES * chacha::BLOCK_BYTES);
+    const size_t numChunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const chacha::Isa isa = chacha::activeIsa();
+    
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel
+    {
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+            size_t offset = chunkIdx * CHUNK_SIZE;
+            size_t chunkLen = std::min(CHUNK_SIZE, size - offset);
+            
+            std::array<uint8_t, 16> chunkIV;
+            std::memcpy(chunkIV.data(), actualIV, 16);
+            chacha::addCounter(chunkIV.data(), offset / chacha::BLOCK_BYTES);
+            
+            chacha::xorKeystream(key, chunkIV.data(), input + offset, output + offset, chunkLen, isa);
+        }
+        
+        #pragma omp master
+        region.workDone();
+    }
+    
+    region.finish();
+#else
+    PhaseScope phase(phases_, Phase::Compute);
+    chacha::xorKeystream(key, actualIV, input, output, size);
+#endif
+}
+
+void ChaCha20OpenMPEngine::encryptBatch(const CipherJob* jobs, size_t count) {
+    size_t totalBytes = 0;
+    for (size_t j = 0; j < count; ++j) {
+        if (jobs[j].keyLen != 32) {
+            throw std::runtime_error("ChaCha20 requires 32-byte key");
+        }
+        totalBytes += jobs[j].size;
+    }
+    
+#ifdef HAS_OPENMP
+    OmpTuning tuning;
+    getTuning(totalBytes, tuning);
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
+    }
+    applyOmpSchedule(tuning.schedule);
+    
+    const size_t CHUNK_SIZE = std::max(chacha::BLOCK_BYTES,
+                                       tuning.chunkBytes / chacha::BLOCK_BYTES * chacha::BLOCK_BYTES);
+    const std::vector<CipherJobChunk> chunks = splitJobs(jobs, count, CHUNK_SIZE);
+    const chacha::Isa isa = chacha::activeIsa();
+    
+    ParallelRegionTimer region(phases_);
+    
+    #pragma omp parallel
+    {
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const CipherJob& job = jobs[chunks[c].job];
+            
+            std::array<uint8_t, 16> chunkIV;
+            std::memcpy(chunkIV.data(), job.iv ? job.iv : defaultIV_.data(), 16);
+            chacha::addCounter(chunkIV.data(), chunks[c].offset / chacha::BLOCK_BYTES);
+            
+            chacha::xorKeystream(job.key, chunkIV.data(), job.input + chunks[c].offset,
+                                 job.output + chunks[c].offset, chunks[c].size, isa);
+        }
+        
+        #pragma omp master
+        region.workDone();
+    }
+    
+    region.finish();
+#else
+    ICipherEngine::encryptBatch(jobs, count);
+#endif
+}
+
+void ChaCha20OpenMPEngine::decrypt(const uint8_t* input, uint8_t* output, 
+                                   size_t size, const uint8_t* key, size_t keyLen,
+                                   const uint8_t* iv) {
+    encrypt(input, output, size, key, keyLen, iv);
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <array>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// ChaCha20 over 64-byte-aligned chunks; each chunk starts its keystream by
+// advancing the block counter, so the output matches the sequential engine.
+class ChaCha20OpenMPEngine : public ICipherEngine {
+public:
+    ChaCha20OpenMPEngine();
+    
+    std::string getAlgorithmName() const override { return "ChaCha20"; }
+    std::string getEngineName() const override { return "OpenMP"; }
+    
+    void encrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    void decrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    // One parallel region over the chunks of every job.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
+    bool isAvailable() const override;
+    void initialize() override;
+    
+    void setNumThreads(int threads) override { numThreads_ = threads; }
+    
+    // Pins the schedule and chunk size, bypassing the tuning cache.
+    void setTuning(const OmpTuning& tuning) override;
+    bool getTuning(size_t size, OmpTuning& tuning) const override;
+    
+private:
+    int numThreads_ = 0;
+    OmpTuning tuning_{0, OmpSchedule::Static, 256 * 1024};
+    bool tuningPinned_ = false;
+    std::vector<TuningEntry> tuned_;
+    std::array<uint8_t, 16> defaultIV_;
+};
+
+}
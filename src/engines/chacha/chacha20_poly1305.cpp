@@ -0,0 +1,90 @@
+#include "chacha20_poly1305.hpp"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+#include <array>
+
+namespace hpc_benchmark {
+
+struct ChaCha20Poly1305Engine::Impl {
+    EVP_CIPHER_CTX* ctx = nullptr;
+    std::array<uint8_t, 16> defaultIV;
+    std::array<uint8_t, 16> tag{};
+    
+    Impl() {
+        ctx = EVP_CIPHER_CTX_new();
+        RAND_bytes(defaultIV.data(), 16);
+    }
+    
+    ~Impl() {
+        if (ctx) EVP_CIPHER_CTX_free(ctx);
+    }
+};
+
+ChaCha20Poly1305Engine::ChaCha20Poly1305Engine() : impl_(new Impl()) {}
+
+ChaCha20Poly1305Engine::~ChaCha20Poly1305Engine() {
+    delete impl_;
+}
+
+bool ChaCha20Poly1305Engine::isAvailable() const {
+    return true;
+}
+
+void ChaCha20Poly1305Engine::encrypt(const uint8_t* input, uint8_t* output, 
+                                     size_t size, const uint8_t* key, size_t keyLen,
+                                     const uint8_t* iv) {
+    if (keyLen != 32) {
+        throw std::runtime_error("ChaCha20 requires 32-byte key");
+    }
+    
+    const uint8_t* nonce = (iv ? iv : impl_->defaultIV.data()) + 4;
+    
+    PhaseScope phase(phases_, Phase::Setup);
+    EVP_CIPHER_CTX_reset(impl_->ctx);
+    
+    phase.next(Phase::KeySchedule);
+    if (EVP_EncryptInit_ex(impl_->ctx, EVP_chacha20_poly1305(), nullptr, key, nonce) != 1) {
+        throw std::runtime_error("EVP_EncryptInit_ex failed");
+    }
+    
+    phase.next(Phase::Compute);
+    int outLen = 0;
+    if (EVP_EncryptUpdate(impl_->ctx, output, &outLen, input, static_cast<int>(size)) != 1) {
+        throw std::runtime_error("EVP_EncryptUpdate failed");
+    }
+    
+    // The final Poly1305 block and tag are reported as Teardown.
+    phase.next(Phase::Teardown);
+    if (EVP_EncryptFinal_ex(impl_->ctx, output + outLen, &outLen) != 1 ||
+        EVP_CIPHER_CTX_ctrl(impl_->ctx, EVP_CTRL_AEAD_GET_TAG, 16, impl_->tag.data()) != 1) {
+        throw std::runtime_error("Poly1305 tag generation failed");
+    }
+}
+
+void ChaCha20Poly1305Engine::decrypt(const uint8_t* input, uint8_t* output, 
+                                     size_t size, const uint8_t* key, size_t keyLen,
+                                     const uint8_t* iv) {
+    if (keyLen != 32) {
+        throw std::runtime_error("ChaCha20 requires 32-byte key");
+    }
+    
+    const uint8_t* nonce = (iv ? iv : impl_->defaultIV.data()) + 4;
+    
+    EVP_CIPHER_CTX_reset(impl_->ctx);
+    if (EVP_DecryptInit_ex(impl_->ctx, EVP_chacha20_poly1305(), nullptr, key, nonce) != 1) {
+        throw std::runtime_error("EVP_DecryptInit_ex failed");
+    }
+    
+    int outLen = 0;
+    if (EVP_DecryptUpdate(impl_->ctx, output, &outLen, input, static_cast<int>(size)) != 1) {
+        throw std::runtime_error("EVP_DecryptUpdate failed");
+    }
+    
+    EVP_CIPHER_CTX_ctrl(impl_->ctx, EVP_CTRL_AEAD_SET_TAG, 16, impl_->tag.data());
+    if (EVP_DecryptFinal_ex(impl_->ctx, output + outLen, &outLen) != 1) {
+        throw std::runtime_error("ChaCha20-Poly1305 authentication failed");
+    }
+}
+
+}
@@ -0,0 +1,29 @@
+#include "chacha20_sequential.hpp"
+#include "kernels/chacha20.hpp"
+#include <openssl/rand.h>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+ChaCha20SequentialEngine::ChaCha20SequentialEngine() {
+    RAND_bytes(defaultIV_.data(), 16);
+}
+
+void ChaCha20SequentialEngine::encrypt(const uint8_t* input, uint8_t* output, 
+                                       size_t size, const uint8_t* key, size_t keyLen,
+                                       const uint8_t* iv) {
+    if (keyLen != 32) {
+        throw std::runtime_error("ChaCha20 requires 32-byte key");
+    }
+    
+    PhaseScope phase(phases_, Phase::Compute);
+    chacha::xorKeystream(key, iv ? iv : defaultIV_.data(), input, output, size);
+}
+
+void ChaCha20SequentialEngine::decrypt(const uint8_t* input, uint8_t* output, 
+                                       size_t size, const uint8_t* key, size_t keyLen,
+                                       const uint8_t* iv) {
+    encrypt(input, output, size, key, keyLen, iv);
+}
+
+}
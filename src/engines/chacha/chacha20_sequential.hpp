@@ -0,0 +1,31 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <array>
+
+namespace hpc_benchmark {
+
+// ChaCha20 (RFC 8439 block function, OpenSSL EVP_chacha20 IV layout) on the
+// calling thread, using the active multi-block kernel (see chacha::activeIsa).
+class ChaCha20SequentialEngine : public ICipherEngine {
+public:
+    ChaCha20SequentialEngine();
+    
+    std::string getAlgorithmName() const override { return "ChaCha20"; }
+    std::string getEngineName() const override { return "Sequential"; }
+    
+    void encrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    void decrypt(const uint8_t* input, uint8_t* output, 
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+    
+    bool isAvailable() const override { return true; }
+    
+private:
+    std::array<uint8_t, 16> defaultIV_;
+};
+
+}
@@ -0,0 +1,158 @@
+#include "dispatch_engine.hpp"
+#include "common/timer.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace hpc_benchmark {
+
+namespace {
+
+// Throughput at the measured size class nearest to `sizeClass`, 0 if none.
+double nearestThroughput(const std::map<int, double>& table, int sizeClass) {
+    double best = 0;
+    int bestDistance = -1;
+    for (const auto& entry : table) {
+        int distance = std::abs(entry.first - sizeClass);
+        if (bestDistance < 0 || distance < bestDistance) {
+            bestDistance = distance;
+            best = entry.second;
+        }
+    }
+    return best;
+}
+
+}
+
+DispatchEngine::DispatchEngine(const std::string& algorithm, const EngineRegistry& registry)
+    : algorithm_(algorithm) {
+    for (const EngineDescriptor* d : registry.forAlgorithm(algorithm)) {
+        CipherEnginePtr engine = d->create();
+        if (engine->isAvailable()) {
+            members_.push_back(Member{d->caps, std::move(engine), {}});
+        }
+    }
+    if (members_.empty()) {
+        throw std::runtime_error("No available engine for " + algorithm);
+    }
+}
+
+void DispatchEngine::initialize() {
+    const TuningCache& cache = TuningCache::shared();
+    for (auto& m : members_) {
+        m.engine->initialize();
+        for (const auto& e : cache.entriesFor(algorithm_, m.caps.engine)) {
+            double& mbs = m.throughputMBs[e.sizeClass];
+            mbs = std::max(mbs, e.throughputMBs);
+        }
+    }
+}
+
+void DispatchEngine::cleanup() {
+    for (auto& m : members_) {
+        m.engine->cleanup();
+    }
+}
+
+void DispatchEngine::setNumThreads(int threads) {
+    for (auto& m : members_) {
+        m.engine->setNumThreads(threads);
+    }
+}
+
+bool DispatchEngine::getTuning(size_t size, OmpTuning& tuning) const {
+    return select(size).getTuning(size, tuning);
+}
+
+size_t DispatchEngine::getKeyBytes() const {
+    return members_.empty() ? ICipherEngine::getKeyBytes() : members_.front().engine->getKeyBytes();
+}
+
+void DispatchEngine::calibrate(const std::vector<size_t>& sizes, int repetitions) {
+    // Distinct key bytes: XTS rejects a key whose two halves are equal.
+    std::vector<uint8_t> key(MAX_KEY_BYTES);
+    for (size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<uint8_t>(0x2b + i);
+    }
+    std::vector<uint8_t> iv(16, 0);
+
+    for (size_t size : sizes) {
+        std::vector<uint8_t> input(size, 0x5a);
+        std::vector<uint8_t> output(size);
+
+        for (auto& m : members_) {
+            ICipherEngine& engine = *m.engine;
+            engine.encrypt(input.data(), output.data(), size, key.data(), engine.getKeyBytes(), iv.data());
+
+            double best = 0;
+            Timer timer;
+            for (int r = 0; r < repetitions; ++r) {
+                timer.start();
+                engine.encrypt(input.data(), output.data(), size, key.data(), engine.getKeyBytes(), iv.data());
+                timer.stop();
+                double sec = timer.elapsedSeconds();
+                if (sec > 0) {
+                    best = std::max(best, (size / (1024.0 * 1024.0)) / sec);
+                }
+            }
+            m.throughputMBs[sizeClassOf(size)] = best;
+        }
+    }
+}
+
+bool DispatchEngine::isCalibrated() const {
+    int measured = 0;
+    for (const auto& m : members_) {
+        if (!m.throughputMBs.empty()) ++measured;
+    }
+    return measured >= std::min<int>(2, static_cast<int>(members_.size()));
+}
+
+ICipherEngine& DispatchEngine::select(size_t size) const {
+    const Member* best = nullptr;
+
+    if (isCalibrated()) {
+        int sizeClass = sizeClassOf(size);
+        double bestMBs = 0;
+        for (const auto& m : members_) {
+            double mbs = nearestThroughput(m.throughputMBs, sizeClass);
+            if (mbs > bestMBs) {
+                bestMBs = mbs;
+                best = &m;
+            }
+        }
+    }
+
+    if (!best) {
+        for (const auto& m : members_) {
+            if (m.caps.minEfficientSize <= size &&
+                (!best || m.caps.minEfficientSize >= best->caps.minEfficientSize)) {
+                best = &m;
+            }
+        }
+    }
+
+    return *(best ? best : &members_.front())->engine;
+}
+
+void DispatchEngine::encrypt(const uint8_t* input, uint8_t* output,
+                              size_t size, const uint8_t* key, size_t keyLen,
+                              const uint8_t* iv) {
+    ICipherEngine& engine = select(size);
+    lastEngine_ = engine.getEngineName();
+    engine.setPhaseRecorder(phases_);
+    engine.encrypt(input, output, size, key, keyLen, iv);
+    engine.setPhaseRecorder(nullptr);
+}
+
+void DispatchEngine::decrypt(const uint8_t* input, uint8_t* output,
+                              size_t size, const uint8_t* key, size_t keyLen,
+                              const uint8_t* iv) {
+    ICipherEngine& engine = select(size);
+    lastEngine_ = engine.getEngineName();
+    engine.setPhaseRecorder(phases_);
+    engine.decrypt(input, output, size, key, keyLen, iv);
+    engine.setPhaseRecorder(nullptr);
+}
+
+}
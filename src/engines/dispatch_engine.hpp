@@ -0,0 +1,56 @@
+#pragma once
+
+#include "engines/engine_registry.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Routes each call to the fastest available engine for the payload size.
+// Throughput comes from calibrate() or, failing that, from the tuning cache
+// (the autotuner records Sequential and OpenMP per size class); with no
+// data each engine's minEfficientSize decides.
+class DispatchEngine : public ICipherEngine {
+public:
+    explicit DispatchEngine(const std::string& algorithm,
+                            const EngineRegistry& registry = EngineRegistry::instance());
+
+    std::string getAlgorithmName() const override { return algorithm_; }
+    std::string getEngineName() const override { return "Dispatch"; }
+
+    void encrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+
+    void decrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+
+    bool isAvailable() const override { return !members_.empty(); }
+    void initialize() override;
+    void cleanup() override;
+
+    void setNumThreads(int threads) override;
+    bool getTuning(size_t size, OmpTuning& tuning) const override;
+    size_t getKeyBytes() const override;
+
+    void calibrate(const std::vector<size_t>& sizes, int repetitions = 3);
+    bool isCalibrated() const;
+
+    ICipherEngine& select(size_t size) const;
+    const std::string& getLastEngine() const { return lastEngine_; }
+
+private:
+    struct Member {
+        EngineCapabilities caps;
+        CipherEnginePtr engine;
+        std::map<int, double> throughputMBs;
+    };
+
+    std::string algorithm_;
+    std::vector<Member> members_;
+    std::string lastEngine_;
+};
+
+}
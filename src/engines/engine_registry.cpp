@@ -0,0 +1,199 @@
+#include "engine_registry.hpp"
+#include "engines/xor/xor_sequential.hpp"
+#include "engines/aes/aes_sequential.hpp"
+#include "engines/aes/aes_gcm_sequential.hpp"
+#include "engines/aes/aes_gcm_chunked.hpp"
+#include "engines/aes/aes_xts.hpp"
+#include "engines/aes/aes_cbc.hpp"
+#include "engines/aes/aes_cbc_multibuffer.hpp"
+#include "engines/aes/aes_multibuffer.hpp"
+#include "engines/chacha/chacha20_sequential.hpp"
+#include "engines/chacha/chacha20_poly1305.hpp"
+#include <openssl/opensslconf.h>
+#include <stdexcept>
+
+#ifdef HAS_OPENMP
+#include "engines/xor/xor_openmp.hpp"
+#include "engines/aes/aes_openmp.hpp"
+#include "engines/chacha/chacha20_openmp.hpp"
+#endif
+
+#ifdef HAS_OPENCL
+#include "engines/xor/xor_opencl.hpp"
+#include "engines/aes/aes_opencl.hpp"
+#endif
+
+#ifdef HAS_CUDA
+#include "engines/xor/xor_cuda.cuh"
+#include "engines/aes/aes_cuda.cuh"
+#endif
+
+#ifdef HAS_METAL
+#include "engines/xor/xor_metal.hpp"
+#include "engines/aes/aes_metal.hpp"
+#endif
+
+namespace hpc_benchmark {
+
+namespace {
+
+EngineCapabilities makeCaps(const std::string& algorithm, const std::string& engine,
+                             size_t minEfficientSize, bool threadControl, bool accelerator,
+                             int keyBits) {
+    EngineCapabilities caps;
+    caps.algorithm = algorithm;
+    caps.engine = engine;
+    caps.minEfficientSize = minEfficientSize;
+    caps.threadControl = threadControl;
+    caps.accelerator = accelerator;
+    caps.keyBits = keyBits;
+    return caps;
+}
+
+template <typename Engine>
+void addEngine(EngineRegistry& registry, const std::string& algorithm, const std::string& engine,
+               size_t minEfficientSize, bool threadControl, bool accelerator, int keyBits = 0) {
+    registry.add(makeCaps(algorithm, engine, minEfficientSize, threadControl, accelerator, keyBits),
+                 [] { return CipherEnginePtr(new Engine()); });
+}
+
+// Authenticated engines carry their tag bytes next to the ciphertext.
+void addAeadEngine(EngineRegistry& registry, const std::string& algorithm, const std::string& engine,
+                   size_t minEfficientSize, bool threadControl, int keyBits, EngineFactory factory) {
+    EngineCapabilities caps = makeCaps(algorithm, engine, minEfficientSize, threadControl, false, keyBits);
+    caps.authenticated = true;
+    registry.add(caps, std::move(factory));
+}
+
+template <int KeyBits>
+void addAesSequentialEngines(EngineRegistry& registry) {
+    using Traits = AesKeyTraits<KeyBits>;
+    addEngine<AesSequentialEngine<KeyBits>>(registry, Traits::algorithmName("CTR"), "Sequential",
+                                            0, false, false, KeyBits);
+    addAeadEngine(registry, Traits::algorithmName("GCM"), "Sequential", 0, false, KeyBits,
+                  [] { return CipherEnginePtr(new AesGcmSequentialEngine<KeyBits>()); });
+    // The chunked GCM format has its own Sequential reference, so OpenMP
+    // speedups and verification compare identical ciphertext and tags.
+    addAeadEngine(registry, Traits::algorithmName("GCM-Chunked"), "Sequential", 0, false, KeyBits,
+                  [] { return CipherEnginePtr(new AesGcmChunkedEngine<KeyBits>(false)); });
+}
+
+#ifdef HAS_OPENMP
+template <int KeyBits>
+void addAesOpenMPEngines(EngineRegistry& registry) {
+    using Traits = AesKeyTraits<KeyBits>;
+    addEngine<AesOpenMPEngine<KeyBits>>(registry, Traits::algorithmName("CTR"), "OpenMP",
+                                        256 * 1024, true, false, KeyBits);
+    addAeadEngine(registry, Traits::algorithmName("GCM-Chunked"), "OpenMP", 256 * 1024, true, KeyBits,
+                  [] { return CipherEnginePtr(new AesGcmChunkedEngine<KeyBits>(true)); });
+}
+#endif
+
+void registerBuiltins(EngineRegistry& registry) {
+    addEngine<XorSequentialEngine>(registry, "XOR", "Sequential", 0, false, false);
+    addAesSequentialEngines<128>(registry);
+    addAesSequentialEngines<192>(registry);
+    addAesSequentialEngines<256>(registry);
+    registry.add(makeCaps("AES-256-XTS", "Sequential", 0, false, false, 256),
+                 [] { return CipherEnginePtr(new AesXtsEngine(false)); });
+    registry.add(makeCaps("AES-256-CBC", "Sequential", 0, false, false, 256),
+                 [] { return CipherEnginePtr(new AesCbcEngine(false)); });
+    addEngine<ChaCha20SequentialEngine>(registry, "ChaCha20", "Sequential", 0, false, false);
+#ifndef OPENSSL_NO_POLY1305
+    addAeadEngine(registry, "ChaCha20-Poly1305", "Sequential", 0, false, 0,
+                  [] { return CipherEnginePtr(new ChaCha20Poly1305Engine()); });
+#endif
+
+#ifdef HAS_OPENMP
+    addEngine<XorOpenMPEngine>(registry, "XOR", "OpenMP", 256 * 1024, true, false);
+    addAesOpenMPEngines<128>(registry);
+    addAesOpenMPEngines<192>(registry);
+    addAesOpenMPEngines<256>(registry);
+    registry.add(makeCaps("AES-256-XTS", "OpenMP", 64 * 1024, true, false, 256),
+                 [] { return CipherEnginePtr(new AesXtsEngine(true)); });
+    registry.add(makeCaps("AES-256-CBC", "OpenMP", 256 * 1024, true, false, 256),
+                 [] { return CipherEnginePtr(new AesCbcEngine(true)); });
+    addEngine<ChaCha20OpenMPEngine>(registry, "ChaCha20", "OpenMP", 256 * 1024, true, false);
+#endif
+
+    // Single-threaded; built for many short messages through encryptBatch().
+    addEngine<AesMultiBufferEngine<128>>(registry, "AES-128-CTR", "MultiBuf", 0, false, false, 128);
+    addEngine<AesMultiBufferEngine<192>>(registry, "AES-192-CTR", "MultiBuf", 0, false, false, 192);
+    addEngine<AesMultiBufferEngine<256>>(registry, "AES-256-CTR", "MultiBuf", 0, false, false, 256);
+    addEngine<AesCbcMultiBufferEngine>(registry, "AES-256-CBC", "MultiBuf", 0, false, false, 256);
+
+#ifdef HAS_METAL
+    addEngine<XorMetalEngine>(registry, "XOR", "Metal", 4 * 1024 * 1024, false, true);
+    addEngine<AesMetalEngine<128>>(registry, "AES-128-CTR", "Metal", 4 * 1024 * 1024, false, true, 128);
+    addEngine<AesMetalEngine<192>>(registry, "AES-192-CTR", "Metal", 4 * 1024 * 1024, false, true, 192);
+    addEngine<AesMetalEngine<256>>(registry, "AES-256-CTR", "Metal", 4 * 1024 * 1024, false, true, 256);
+#endif
+
+#ifdef HAS_CUDA
+    addEngine<XorCudaEngine>(registry, "XOR", "CUDA", 16 * 1024 * 1024, false, true);
+    addEngine<AesCudaEngine<128>>(registry, "AES-128-CTR", "CUDA", 16 * 1024 * 1024, false, true, 128);
+    addEngine<AesCudaEngine<192>>(registry, "AES-192-CTR", "CUDA", 16 * 1024 * 1024, false, true, 192);
+    addEngine<AesCudaEngine<256>>(registry, "AES-256-CTR", "CUDA", 16 * 1024 * 1024, false, true, 256);
+#endif
+
+#ifdef HAS_OPENCL
+    addEngine<XorOpenCLEngine>(registry, "XOR", "OpenCL", 16 * 1024 * 1024, false, true);
+    addEngine<AesOpenCLEngine<128>>(registry, "AES-128-CTR", "OpenCL", 16 * 1024 * 1024, false, true, 128);
+    addEngine<AesOpenCLEngine<192>>(registry, "AES-192-CTR", "OpenCL", 16 * 1024 * 1024, false, true, 192);
+    addEngine<AesOpenCLEngine<256>>(registry, "AES-256-CTR", "OpenCL", 16 * 1024 * 1024, false, true, 256);
+#endif
+}
+
+}
+
+EngineRegistry& EngineRegistry::instance() {
+    static EngineRegistry registry = [] {
+        EngineRegistry r;
+        registerBuiltins(r);
+        return r;
+    }();
+    return registry;
+}
+
+void EngineRegistry::add(const EngineCapabilities& caps, EngineFactory factory) {
+    engines_.push_back(EngineDescriptor{caps, std::move(factory)});
+}
+
+std::vector<const EngineDescriptor*> EngineRegistry::forAlgorithm(const std::string& algorithm) const {
+    std::vector<const EngineDescriptor*> result;
+    for (const auto& d : engines_) {
+        if (d.caps.algorithm == algorithm) {
+            result.push_back(&d);
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> EngineRegistry::algorithms() const {
+    std::vector<std::string> result;
+    for (const auto& d : engines_) {
+        bool seen = false;
+        for (const auto& a : result) seen = seen || a == d.caps.algorithm;
+        if (!seen) result.push_back(d.caps.algorithm);
+    }
+    return result;
+}
+
+const EngineDescriptor* EngineRegistry::find(const std::string& algorithm, const std::string& engine) const {
+    for (const auto& d : engines_) {
+        if (d.caps.algorithm == algorithm && d.caps.engine == engine) {
+            return &d;
+        }
+    }
+    return nullptr;
+}
+
+CipherEnginePtr EngineRegistry::create(const std::string& algorithm, const std::string& engine) const {
+    const EngineDescriptor* d = find(algorithm, engine);
+    if (!d) {
+        throw std::runtime_error("No " + engine + " engine registered for " + algorithm);
+    }
+    return d->create();
+}
+
+}
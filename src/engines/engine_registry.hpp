@@ -0,0 +1,46 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+struct EngineCapabilities {
+    std::string algorithm;
+    std::string engine;
+    size_t minEfficientSize = 0;
+    bool threadControl = false;
+    bool accelerator = false;
+    bool authenticated = false;
+    int keyBits = 0;  // AES key size of this variant; 0 for fixed-key algorithms
+};
+
+using EngineFactory = std::function<CipherEnginePtr()>;
+
+struct EngineDescriptor {
+    EngineCapabilities caps;
+    EngineFactory create;
+};
+
+// Every engine compiled into this build, in registration order: sequential
+// references first, then CPU-parallel, then accelerators.
+class EngineRegistry {
+public:
+    static EngineRegistry& instance();
+
+    void add(const EngineCapabilities& caps, EngineFactory factory);
+
+    const std::vector<EngineDescriptor>& all() const { return engines_; }
+    std::vector<const EngineDescriptor*> forAlgorithm(const std::string& algorithm) const;
+    std::vector<std::string> algorithms() const;
+
+    const EngineDescriptor* find(const std::string& algorithm, const std::string& engine) const;
+    CipherEnginePtr create(const std::string& algorithm, const std::string& engine) const;
+
+private:
+    std::vector<EngineDescriptor> engines_;
+};
+
+}
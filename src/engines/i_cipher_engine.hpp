@@ -1,5 +1,10 @@
 #pragma once
 
+#include "common/phase_timer.hpp"
+#include "common/perf_counters.hpp"
+#include "common/power_monitor.hpp"
+#include "common/tuning_cache.hpp"
+#include <algorithm>
 #include <string>
 #include <cstdint>
 #include <cstddef>
@@ -8,6 +13,35 @@
 
 namespace hpc_benchmark {
 
+// One independent message of a batch submission.
+struct CipherJob {
+    const uint8_t* input;
+    uint8_t* output;
+    size_t size;
+    const uint8_t* key;
+    size_t keyLen;
+    const uint8_t* iv;
+};
+
+// Slice of a batch job no longer than the chunk size it was split with.
+struct CipherJobChunk {
+    size_t job;
+    size_t offset;
+    size_t size;
+};
+
+// Flattens a batch into chunks of at most chunkBytes (a multiple of the
+// cipher's block), so one parallel loop covers every job of the batch.
+inline std::vector<CipherJobChunk> splitJobs(const CipherJob* jobs, size_t count, size_t chunkBytes) {
+    std::vector<CipherJobChunk> chunks;
+    for (size_t j = 0; j < count; ++j) {
+        for (size_t offset = 0; offset < jobs[j].size; offset += chunkBytes) {
+            chunks.push_back(CipherJobChunk{j, offset, std::min(chunkBytes, jobs[j].size - offset)});
+        }
+    }
+    return chunks;
+}
+
 class ICipherEngine {
 public:
     virtual ~ICipherEngine() = default;
@@ -23,16 +57,53 @@ public:
                         size_t size, const uint8_t* key, size_t keyLen,
                         const uint8_t* iv = nullptr) = 0;
     
+    // Encrypts count independent jobs. The default is one encrypt() per
+    // job; engines override it to pay their per-call setup (parallel
+    // region, key schedule, device transfer and launch) once per batch.
+    virtual void encryptBatch(const CipherJob* jobs, size_t count) {
+        for (size_t j = 0; j < count; ++j) {
+            encrypt(jobs[j].input, jobs[j].output, jobs[j].size, jobs[j].key, jobs[j].keyLen, jobs[j].iv);
+        }
+    }
+    
+    // Builds the per-key state encrypt() would build for key (expanded
+    // schedule, keyed context) into the shared key schedule cache, so a
+    // later call with it only looks it up. Must be safe to call from another
+    // thread while the engine encrypts. No-op by default and while the
+    // cache is disabled.
+    virtual void prepareKey(const uint8_t*, size_t) {}
+    
     virtual bool isAvailable() const = 0;
     
     virtual void initialize() {}
     virtual void cleanup() {}
     
     virtual size_t getOptimalBlockSize() const { return 1024 * 1024; }
+    
+    // Engines without thread control ignore these.
+    virtual void setNumThreads(int) {}
+    virtual void setTuning(const OmpTuning&) {}
+    virtual bool getTuning(size_t, OmpTuning&) const { return false; }
+    
+    // Authentication tag bytes emitted alongside `size` bytes of ciphertext;
+    // 0 for unauthenticated ciphers.
+    virtual size_t getTagBytes(size_t) const { return 0; }
+    
+    // Key length encrypt() expects; callers hold MAX_KEY_BYTES of key
+    // material and pass this many leading bytes.
+    virtual size_t getKeyBytes() const { return 32; }
+    
+    void setPhaseRecorder(PhaseTimings* recorder) { phases_ = recorder; }
+    
+protected:
+    PhaseTimings* phases_ = nullptr;
 };
 
 using CipherEnginePtr = std::unique_ptr<ICipherEngine>;
 
+// Longest key any engine takes (AES-256-XTS: two 256-bit keys).
+constexpr size_t MAX_KEY_BYTES = 64;
+
 struct BenchmarkResult {
     std::string platform;
     std::string algorithm;
@@ -47,10 +118,39 @@ struct BenchmarkResult {
     double energyJoules;
     double powerWatts;
     std::string energySource;
+    DomainEnergy energyDomains;
+    int warmupIterations;
+    std::vector<double> timeSamples;
+    double timeMedianSec;
+    double timeMinSec;
+    double timeP95Sec;
+    double timeStddevSec;
+    double timeCILowSec;
+    double timeCIHighSec;
+    PhaseTimings phases;
+    HardwareCounters counters;
+    double effectiveBandwidthGBs;
+    double attainableBandwidthGBs;
+    double bandwidthUtilization;
+    std::string affinity;
+    std::string cpuList;
+    std::string schedule;
+    size_t chunkBytes;
+    int keyBits;
+    // Set when decryption is timed separately (--time-decrypt, CBC).
+    double decryptTimeSec;
+    double decryptTimeMedianSec;
+    double decryptThroughputMBs;
+    double decryptSpeedup;
     
     BenchmarkResult() : platform("Unknown"), fileSizeMB(0), numThreads(1), timeSec(0), 
                         throughputMBs(0), speedup(1.0), efficiency(1.0), verified(false),
-                        energyJoules(0), powerWatts(0), energySource("N/A") {}
+                        energyJoules(0), powerWatts(0), energySource("N/A"), warmupIterations(0),
+                        timeMedianSec(0), timeMinSec(0), timeP95Sec(0), timeStddevSec(0),
+                        timeCILowSec(0), timeCIHighSec(0), effectiveBandwidthGBs(0),
+                        attainableBandwidthGBs(0), bandwidthUtilization(0), affinity("none"),
+                        chunkBytes(0), keyBits(0), decryptTimeSec(0), decryptTimeMedianSec(0),
+                        decryptThroughputMBs(0), decryptSpeedup(0) {}
 };
 
 }
@@ -0,0 +1,189 @@
+#include "split_engine.hpp"
+#include "common/stream_position.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace hpc_benchmark {
+
+namespace {
+
+// Keeps every member measurable after a bad first sample.
+constexpr double MIN_SHARE = 0.02;
+constexpr double SMOOTHING = 0.5;
+
+}
+
+SplitEngine::SplitEngine(const std::string& algorithm, std::vector<CipherEnginePtr> members)
+    : algorithm_(algorithm), members_(std::move(members)), weights_(members_.size(), 0) {
+    if (members_.empty()) {
+        throw std::runtime_error("Split engine needs at least one member");
+    }
+    for (const auto& m : members_) {
+        if (m->getAlgorithmName() != algorithm_) {
+            throw std::runtime_error("Split engine member " + m->getEngineName() +
+                                     " does not implement " + algorithm_);
+        }
+    }
+}
+
+bool SplitEngine::isAvailable() const {
+    for (const auto& m : members_) {
+        if (!m->isAvailable()) return false;
+    }
+    return true;
+}
+
+void SplitEngine::initialize() {
+    for (auto& m : members_) {
+        m->initialize();
+    }
+}
+
+void SplitEngine::cleanup() {
+    for (auto& m : members_) {
+        m->cleanup();
+    }
+}
+
+void SplitEngine::setNumThreads(int threads) {
+    for (auto& m : members_) {
+        m->setNumThreads(threads);
+    }
+}
+
+size_t SplitEngine::getKeyBytes() const {
+    return members_.empty() ? ICipherEngine::getKeyBytes() : members_.front()->getKeyBytes();
+}
+
+void SplitEngine::setWeights(const std::vector<double>& weights) {
+    if (weights.size() != members_.size()) {
+        throw std::runtime_error("Split engine expects one weight per member");
+    }
+    weights_ = weights;
+}
+
+std::string SplitEngine::describeSplit() const {
+    size_t total = 0;
+    for (size_t s : lastSlices_) total += s;
+
+    std::ostringstream out;
+    for (size_t i = 0; i < lastSlices_.size(); ++i) {
+        if (i > 0) out << "+";
+        out << members_[i]->getEngineName() << ":"
+            << (total ? static_cast<int>(100.0 * lastSlices_[i] / total + 0.5) : 0) << "%";
+    }
+    return out.str();
+}
+
+void SplitEngine::encrypt(const uint8_t* input, uint8_t* output,
+                          size_t size, const uint8_t* key, size_t keyLen,
+                          const uint8_t* iv) {
+    run(true, input, output, size, key, keyLen, iv);
+}
+
+void SplitEngine::decrypt(const uint8_t* input, uint8_t* output,
+                          size_t size, const uint8_t* key, size_t keyLen,
+                          const uint8_t* iv) {
+    run(false, input, output, size, key, keyLen, iv);
+}
+
+void SplitEngine::run(bool encrypting, const uint8_t* input, uint8_t* output,
+                      size_t size, const uint8_t* key, size_t keyLen, const uint8_t* iv) {
+    PhaseScope phase(phases_, Phase::Setup);
+    const size_t n = members_.size();
+    const size_t align = streamAlignment(algorithm_);
+
+    // Members without a measurement yet count as average.
+    double known = 0;
+    size_t measured = 0;
+    for (double w : weights_) {
+        if (w > 0) {
+            known += w;
+            ++measured;
+        }
+    }
+    std::vector<double> shares(n);
+    double total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double w = weights_[i] > 0 ? weights_[i] : (measured ? known / measured : 1.0);
+        shares[i] = w;
+        total += w;
+    }
+    for (auto& s : shares) {
+        s = std::max(s / total, MIN_SHARE);
+    }
+    total = 0;
+    for (double s : shares) total += s;
+
+    std::vector<size_t> offsets(n), slices(n);
+    size_t offset = 0;
+    for (size_t i = 0; i < n; ++i) {
+        size_t len = size - offset;
+        if (i + 1 < n) {
+            len = static_cast<size_t>(size * (shares[i] / total));
+            len -= len % align;
+            len = std::min(len, size - offset);
+        }
+        offsets[i] = offset;
+        slices[i] = len;
+        offset += len;
+    }
+
+    std::vector<StreamPosition> positions(n);
+    for (size_t i = 0; i < n; ++i) {
+        positions[i] = seekStream(algorithm_, key, keyLen, iv, offsets[i]);
+    }
+
+    phase.next(Phase::Compute);
+    std::vector<double> seconds(n, 0);
+    std::vector<std::exception_ptr> errors(n);
+
+    auto work = [&](size_t i) {
+        try {
+            auto start = std::chrono::steady_clock::now();
+            const StreamPosition& pos = positions[i];
+            if (encrypting) {
+                members_[i]->encrypt(input + offsets[i], output + offsets[i], slices[i],
+                                     pos.key.data(), pos.key.size(), pos.iv.data());
+            } else {
+                members_[i]->decrypt(input + offsets[i], output + offsets[i], slices[i],
+                                     pos.key.data(), pos.key.size(), pos.iv.data());
+            }
+            seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    // The calling thread takes the last slice instead of idling in join().
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        if (slices[i] > 0) {
+            threads.emplace_back(work, i);
+        }
+    }
+    if (slices[n - 1] > 0) {
+        work(n - 1);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    phase.next(Phase::Teardown);
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (slices[i] == 0 || seconds[i] <= 0) continue;
+        double rate = slices[i] / seconds[i];
+        weights_[i] = weights_[i] > 0 ? (1 - SMOOTHING) * weights_[i] + SMOOTHING * rate : rate;
+    }
+    lastSlices_ = slices;
+}
+
+}
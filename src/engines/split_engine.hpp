@@ -0,0 +1,53 @@
+#pragma once
+
+#include "engines/i_cipher_engine.hpp"
+#include <string>
+#include <vector>
+
+namespace hpc_benchmark {
+
+// Splits one call into contiguous slices, one per member, run concurrently.
+// Each slice is encrypted from its own stream position (seekStream), so the
+// output is byte-identical to a single engine over the whole buffer. Slice
+// sizes follow each member's measured throughput, smoothed across calls.
+class SplitEngine : public ICipherEngine {
+public:
+    SplitEngine(const std::string& algorithm, std::vector<CipherEnginePtr> members);
+
+    std::string getAlgorithmName() const override { return algorithm_; }
+    std::string getEngineName() const override { return "Split"; }
+
+    void encrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+
+    void decrypt(const uint8_t* input, uint8_t* output,
+                size_t size, const uint8_t* key, size_t keyLen,
+                const uint8_t* iv = nullptr) override;
+
+    bool isAvailable() const override;
+    void initialize() override;
+    void cleanup() override;
+
+    void setNumThreads(int threads) override;
+    size_t getKeyBytes() const override;
+
+    // Throughput estimate per member in bytes/s (0 = not yet measured);
+    // replaced by smoothed measurements after every call.
+    void setWeights(const std::vector<double>& weights);
+    const std::vector<double>& getWeights() const { return weights_; }
+
+    // "OpenMP:70%+Sequential:30%" for the most recent call.
+    std::string describeSplit() const;
+
+private:
+    void run(bool encrypting, const uint8_t* input, uint8_t* output,
+             size_t size, const uint8_t* key, size_t keyLen, const uint8_t* iv);
+
+    std::string algorithm_;
+    std::vector<CipherEnginePtr> members_;
+    std::vector<double> weights_;
+    std::vector<size_t> lastSlices_;
+};
+
+}
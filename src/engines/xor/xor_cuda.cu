@@ -91,6 +91,7 @@ void XorCudaEngine::encrypt(const uint8_t* input, uint8_t* output,
         initialize();
     }
     
+    PhaseScope phase(phases_, Phase::Setup);
     if (size > allocatedSize_) {
         if (d_input_) cudaFree(d_input_);
         if (d_output_) cudaFree(d_output_);
@@ -105,9 +106,11 @@ void XorCudaEngine::encrypt(const uint8_t* input, uint8_t* output,
         allocatedKeySize_ = keyLen;
     }
     
+    phase.next(Phase::TransferIn);
     CUDA_CHECK(cudaMemcpy(d_input_, input, size, cudaMemcpyHostToDevice));
     CUDA_CHECK(cudaMemcpy(d_key_, key, keyLen, cudaMemcpyHostToDevice));
     
+    phase.next(Phase::Compute);
     constexpr int THREADS_PER_BLOCK = 256;
     int numBlocks = (size + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
     
@@ -116,8 +119,10 @@ void XorCudaEngine::encrypt(const uint8_t* input, uint8_t* output,
     CUDA_CHECK(cudaGetLastError());
     CUDA_CHECK(cudaDeviceSynchronize());
     
+    phase.next(Phase::TransferOut);
     CUDA_CHECK(cudaMemcpy(output, d_output_, size, cudaMemcpyDeviceToHost));
 #else
+    PhaseScope phase(phases_, Phase::Compute);
     for (size_t i = 0; i < size; ++i) {
         output[i] = input[i] ^ key[i % keyLen];
     }
@@ -144,6 +144,8 @@ void XorMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
         initialize();
     }
     
+    PhaseScope phase(phases_, Phase::TransferIn);
+    
     @autoreleasepool {
         id<MTLBuffer> inputBuffer = [impl_->device newBufferWithBytes:input
                                                                length:size
@@ -164,6 +166,7 @@ void XorMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
         uint32_t keyLenU = static_cast<uint32_t>(keyLen);
         uint64_t sizeU = static_cast<uint64_t>(size);
         
+        phase.next(Phase::Compute);
         id<MTLCommandBuffer> commandBuffer = [impl_->commandQueue commandBuffer];
         id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
         
@@ -188,8 +191,10 @@ void XorMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
         [commandBuffer commit];
         [commandBuffer waitUntilCompleted];
         
+        phase.next(Phase::TransferOut);
         memcpy(output, [outputBuffer contents], size);
         
+        phase.next(Phase::Teardown);
         [inputBuffer setPurgeableState:MTLPurgeableStateEmpty];
         [outputBuffer setPurgeableState:MTLPurgeableStateEmpty];
         [keyBuffer setPurgeableState:MTLPurgeableStateEmpty];
@@ -199,6 +204,7 @@ void XorMetalEngine::encrypt(const uint8_t* input, uint8_t* output,
         keyBuffer = nil;
     }
 #else
+    PhaseScope phase(phases_, Phase::Compute);
     for (size_t i = 0; i < size; ++i) {
         output[i] = input[i] ^ key[i % keyLen];
     }
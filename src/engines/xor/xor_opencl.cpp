@@ -138,6 +138,7 @@ void XorOpenCLEngine::encrypt(const uint8_t* input, uint8_t* output,
         initialize();
     }
     
+    PhaseScope phase(phases_, Phase::TransferIn);
     cl_int err;
     
     cl_mem inputBuf = clCreateBuffer(impl_->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
@@ -149,6 +150,7 @@ void XorOpenCLEngine::encrypt(const uint8_t* input, uint8_t* output,
     cl_uint keyLenU = static_cast<cl_uint>(keyLen);
     cl_ulong sizeU = static_cast<cl_ulong>(size);
     
+    phase.next(Phase::Compute);
     clSetKernelArg(impl_->kernel, 0, sizeof(cl_mem), &inputBuf);
     clSetKernelArg(impl_->kernel, 1, sizeof(cl_mem), &outputBuf);
     clSetKernelArg(impl_->kernel, 2, sizeof(cl_mem), &keyBuf);
@@ -161,13 +163,17 @@ void XorOpenCLEngine::encrypt(const uint8_t* input, uint8_t* output,
     
     err = clEnqueueNDRangeKernel(impl_->queue, impl_->kernel, 1, nullptr, 
                                   &globalSize, &localSize, 0, nullptr, nullptr);
+    clFinish(impl_->queue);
     
+    phase.next(Phase::TransferOut);
     clEnqueueReadBuffer(impl_->queue, outputBuf, CL_TRUE, 0, size, output, 0, nullptr, nullptr);
     
+    phase.next(Phase::Teardown);
     clReleaseMemObject(inputBuf);
     clReleaseMemObject(outputBuf);
     clReleaseMemObject(keyBuf);
 #else
+    PhaseScope phase(phases_, Phase::Compute);
     for (size_t i = 0; i < size; ++i) {
         output[i] = input[i] ^ key[i % keyLen];
     }
@@ -1,4 +1,6 @@
 #include "xor_openmp.hpp"
+#include "kernels/xor_kernel.hpp"
+#include <algorithm>
 
 #ifdef HAS_OPENMP
 #include <omp.h>
@@ -14,22 +16,97 @@ bool XorOpenMPEngine::isAvailable() const {
 #endif
 }
 
+void XorOpenMPEngine::initialize() {
+    tuned_ = TuningCache::shared().entriesFor(getAlgorithmName(), getEngineName());
+}
+
+void XorOpenMPEngine::setTuning(const OmpTuning& tuning) {
+    tuning_ = tuning;
+    tuningPinned_ = true;
+}
+
+bool XorOpenMPEngine::getTuning(size_t size, OmpTuning& tuning) const {
+    OmpTuning base = tuning_;
+    if (numThreads_ > 0) {
+        base.threads = numThreads_;
+    }
+    tuning = tuningPinned_ ? base : resolveTuning(tuned_, size, base);
+    return true;
+}
+
 void XorOpenMPEngine::encrypt(const uint8_t* input, uint8_t* output, 
                                size_t size, const uint8_t* key, size_t keyLen,
                                const uint8_t*) {
 #ifdef HAS_OPENMP
-    if (numThreads_ > 0) {
-        omp_set_num_threads(numThreads_);
+    ParallelRegionTimer region(phases_);
+    
+    OmpTuning tuning;
+    getTuning(size, tuning);
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
     }
+    applyOmpSchedule(tuning.schedule);
+    
+    const size_t blockSize = std::max<size_t>(tuning.chunkBytes, 1);
+    const size_t numBlocks = (size + blockSize - 1) / blockSize;
     
-    #pragma omp parallel for schedule(static)
-    for (size_t i = 0; i < size; ++i) {
-        output[i] = input[i] ^ key[i % keyLen];
+    #pragma omp parallel
+    {
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t b = 0; b < numBlocks; ++b) {
+            size_t begin = b * blockSize;
+            xorcipher::apply(input, output, begin, std::min(size, begin + blockSize), key, keyLen);
+        }
+        
+        #pragma omp master
+        region.workDone();
     }
+    
+    region.finish();
 #else
-    for (size_t i = 0; i < size; ++i) {
-        output[i] = input[i] ^ key[i % keyLen];
+    PhaseScope phase(phases_, Phase::Compute);
+    xorcipher::apply(input, output, 0, size, key, keyLen);
+#endif
+}
+
+void XorOpenMPEngine::encryptBatch(const CipherJob* jobs, size_t count) {
+#ifdef HAS_OPENMP
+    size_t totalBytes = 0;
+    for (size_t j = 0; j < count; ++j) {
+        totalBytes += jobs[j].size;
+    }
+    
+    ParallelRegionTimer region(phases_);
+    
+    OmpTuning tuning;
+    getTuning(totalBytes, tuning);
+    if (tuning.threads > 0) {
+        omp_set_num_threads(tuning.threads);
+    }
+    applyOmpSchedule(tuning.schedule);
+    
+    const std::vector<CipherJobChunk> blocks = splitJobs(jobs, count, std::max<size_t>(tuning.chunkBytes, 1));
+    
+    #pragma omp parallel
+    {
+        region.threadReady();
+        
+        #pragma omp for schedule(runtime)
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            const CipherJob& job = jobs[blocks[b].job];
+            size_t begin = blocks[b].offset;
+            xorcipher::apply(job.input, job.output, begin, begin + blocks[b].size, job.key, job.keyLen);
+        }
+        
+        #pragma omp master
+        region.workDone();
     }
+    
+    region.finish();
+#else
+    ICipherEngine::encryptBatch(jobs, count);
 #endif
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engines/i_cipher_engine.hpp"
+#include <vector>
 
 namespace hpc_benchmark {
 
@@ -17,13 +18,24 @@ public:
                 size_t size, const uint8_t* key, size_t keyLen,
                 const uint8_t* iv = nullptr) override;
     
+    // One parallel region over the blocks of every job.
+    void encryptBatch(const CipherJob* jobs, size_t count) override;
+    
     bool isAvailable() const override;
+    void initialize() override;
     
-    void setNumThreads(int threads) { numThreads_ = threads; }
+    void setNumThreads(int threads) override { numThreads_ = threads; }
     int getNumThreads() const { return numThreads_; }
     
+    // Pins the schedule and block size, bypassing the tuning cache.
+    void setTuning(const OmpTuning& tuning) override;
+    bool getTuning(size_t size, OmpTuning& tuning) const override;
+    
 private:
     int numThreads_ = 0;
+    OmpTuning tuning_{0, OmpSchedule::Static, 64 * 1024};
+    bool tuningPinned_ = false;
+    std::vector<TuningEntry> tuned_;
 };
 
 }
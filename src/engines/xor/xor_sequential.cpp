@@ -1,13 +1,13 @@
 #include "xor_sequential.hpp"
+#include "kernels/xor_kernel.hpp"
 
 namespace hpc_benchmark {
 
 void XorSequentialEngine::encrypt(const uint8_t* input, uint8_t* output, 
                                    size_t size, const uint8_t* key, size_t keyLen,
                                    const uint8_t*) {
-    for (size_t i = 0; i < size; ++i) {
-        output[i] = input[i] ^ key[i % keyLen];
-    }
+    PhaseScope phase(phases_, Phase::Compute);
+    xorcipher::apply(input, output, 0, size, key, keyLen);
 }
 
 void XorSequentialEngine::decrypt(const uint8_t* input, uint8_t* output, 
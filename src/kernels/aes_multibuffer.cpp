@@ -0,0 +1,263 @@
+// Compiled with -maes (see CMakeLists.txt); only reached after a runtime
+// CPU check.
+#include "aes_multibuffer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef HAS_AES_MULTIBUFFER
+#include <wmmintrin.h>
+#endif
+
+namespace hpc_benchmark {
+namespace aes {
+
+#ifdef HAS_AES_MULTIBUFFER
+
+namespace {
+
+struct Lane {
+    const __m128i* roundKeys;
+    const uint8_t* input;
+    uint8_t* output;
+    size_t len;  // 16 except for a message's final partial block
+    __m128i counter;
+};
+
+uint64_t loadBigEndian(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+// Big-endian (hi, lo) as the 16 counter bytes.
+inline __m128i counterBlock(uint64_t hi, uint64_t lo) {
+    return _mm_set_epi64x(static_cast<long long>(__builtin_bswap64(lo)),
+                          static_cast<long long>(__builtin_bswap64(hi)));
+}
+
+// Round-major order: every lane advances one round before any lane takes
+// the next, so consecutive aesenc instructions are independent.
+template <int ROUNDS>
+inline void encryptLanes(const Lane* lanes, int n) {
+    __m128i x[MULTI_BUFFER_LANES];
+    for (int i = 0; i < n; ++i) {
+        x[i] = _mm_xor_si128(lanes[i].counter, _mm_loadu_si128(lanes[i].roundKeys));
+    }
+    for (int r = 1; r < ROUNDS; ++r) {
+        for (int i = 0; i < n; ++i) {
+            x[i] = _mm_aesenc_si128(x[i], _mm_loadu_si128(lanes[i].roundKeys + r));
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        x[i] = _mm_aesenclast_si128(x[i], _mm_loadu_si128(lanes[i].roundKeys + ROUNDS));
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const Lane& lane = lanes[i];
+        if (lane.len == 16) {
+            __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane.input));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lane.output), _mm_xor_si128(in, x[i]));
+        } else {
+            uint8_t keystream[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keystream), x[i]);
+            for (size_t b = 0; b < lane.len; ++b) {
+                lane.output[b] = lane.input[b] ^ keystream[b];
+            }
+        }
+    }
+}
+
+// MULTI_BUFFER_LANES full consecutive blocks of one job: no per-block lane
+// bookkeeping, one round key load per round.
+template <int ROUNDS>
+inline void encryptStride(const __m128i* roundKeys, uint64_t& hi, uint64_t& lo,
+                          const uint8_t* input, uint8_t* output) {
+    __m128i x[MULTI_BUFFER_LANES];
+    __m128i k = _mm_loadu_si128(roundKeys);
+    for (int i = 0; i < MULTI_BUFFER_LANES; ++i) {
+        x[i] = _mm_xor_si128(counterBlock(hi, lo), k);
+        if (++lo == 0) ++hi;
+    }
+    for (int r = 1; r < ROUNDS; ++r) {
+        k = _mm_loadu_si128(roundKeys + r);
+        for (int i = 0; i < MULTI_BUFFER_LANES; ++i) {
+            x[i] = _mm_aesenc_si128(x[i], k);
+        }
+    }
+    k = _mm_loadu_si128(roundKeys + ROUNDS);
+    for (int i = 0; i < MULTI_BUFFER_LANES; ++i) {
+        x[i] = _mm_aesenclast_si128(x[i], k);
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output) + i, _mm_xor_si128(in, x[i]));
+    }
+}
+
+template <int ROUNDS>
+void run(const CtrJob* jobs, size_t count) {
+    constexpr size_t STRIDE_BYTES = MULTI_BUFFER_LANES * 16;
+    Lane lanes[MULTI_BUFFER_LANES];
+    int n = 0;
+
+    for (size_t j = 0; j < count; ++j) {
+        const CtrJob& job = jobs[j];
+        const __m128i* roundKeys = reinterpret_cast<const __m128i*>(job.roundKeys);
+        uint64_t hi = loadBigEndian(job.counter);
+        uint64_t lo = loadBigEndian(job.counter + 8);
+
+        size_t offset = 0;
+        while (offset < job.size) {
+            // Long runs go straight through; only the short pieces that
+            // would leave lanes idle are gathered across jobs.
+            if (n == 0 && job.size - offset >= STRIDE_BYTES) {
+                encryptStride<ROUNDS>(roundKeys, hi, lo, job.input + offset, job.output + offset);
+                offset += STRIDE_BYTES;
+                continue;
+            }
+
+            Lane& lane = lanes[n];
+            lane.roundKeys = roundKeys;
+            lane.input = job.input + offset;
+            lane.output = job.output + offset;
+            lane.len = std::min<size_t>(16, job.size - offset);
+            lane.counter = counterBlock(hi, lo);
+            if (++lo == 0) ++hi;
+            offset += lane.len;
+
+            if (++n == MULTI_BUFFER_LANES) {
+                encryptLanes<ROUNDS>(lanes, MULTI_BUFFER_LANES);
+                n = 0;
+            }
+        }
+    }
+
+    if (n > 0) {
+        encryptLanes<ROUNDS>(lanes, n);
+    }
+}
+
+// A CBC message in flight: the next block's input and the previous
+// ciphertext block.
+struct CbcStream {
+    const __m128i* roundKeys;
+    const __m128i* input;
+    __m128i* output;
+    size_t blocks;
+    __m128i chain;
+};
+
+// The last stream left: nothing to interleave with, so keep the schedule
+// in registers and chain straight through.
+template <int ROUNDS>
+inline void finishCbc(CbcStream& s) {
+    __m128i k[ROUNDS + 1];
+    for (int r = 0; r <= ROUNDS; ++r) k[r] = _mm_loadu_si128(s.roundKeys + r);
+    __m128i chain = s.chain;
+    for (size_t b = 0; b < s.blocks; ++b) {
+        __m128i x = _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128(s.input + b), chain), k[0]);
+        for (int r = 1; r < ROUNDS; ++r) x = _mm_aesenc_si128(x, k[r]);
+        chain = _mm_aesenclast_si128(x, k[ROUNDS]);
+        _mm_storeu_si128(s.output + b, chain);
+    }
+}
+
+template <int ROUNDS>
+void runCbc(const CbcJob* jobs, size_t count) {
+    CbcStream streams[MULTI_BUFFER_LANES];
+    int n = 0;
+    size_t next = 0;
+
+    auto start = [&](CbcStream& s) {
+        while (next < count) {
+            const CbcJob& job = jobs[next++];
+            if (job.size < 16) continue;
+            s.roundKeys = reinterpret_cast<const __m128i*>(job.roundKeys);
+            s.input = reinterpret_cast<const __m128i*>(job.input);
+            s.output = reinterpret_cast<__m128i*>(job.output);
+            s.blocks = job.size / 16;
+            s.chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(job.iv));
+            return true;
+        }
+        return false;
+    };
+
+    while (n < MULTI_BUFFER_LANES && start(streams[n])) ++n;
+
+    while (n > 1) {
+        __m128i x[MULTI_BUFFER_LANES];
+        for (int i = 0; i < n; ++i) {
+            __m128i in = _mm_loadu_si128(streams[i].input);
+            x[i] = _mm_xor_si128(_mm_xor_si128(in, streams[i].chain), _mm_loadu_si128(streams[i].roundKeys));
+        }
+        for (int r = 1; r < ROUNDS; ++r) {
+            for (int i = 0; i < n; ++i) {
+                x[i] = _mm_aesenc_si128(x[i], _mm_loadu_si128(streams[i].roundKeys + r));
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            CbcStream& s = streams[i];
+            s.chain = _mm_aesenclast_si128(x[i], _mm_loadu_si128(s.roundKeys + ROUNDS));
+            _mm_storeu_si128(s.output, s.chain);
+            ++s.input;
+            ++s.output;
+            --s.blocks;
+        }
+
+        // Refill finished lanes; when the jobs run out, the last lane moves
+        // into the gap.
+        for (int i = 0; i < n;) {
+            if (streams[i].blocks == 0 && !start(streams[i])) {
+                streams[i] = streams[--n];
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    if (n == 1) {
+        finishCbc<ROUNDS>(streams[0]);
+    }
+}
+
+}
+
+bool multiBufferSupported() {
+    return __builtin_cpu_supports("aes");
+}
+
+void ctrMultiBuffer(const CtrJob* jobs, size_t count, int rounds) {
+    switch (rounds) {
+        case 10: run<10>(jobs, count); break;
+        case 12: run<12>(jobs, count); break;
+        case 14: run<14>(jobs, count); break;
+        default: throw std::runtime_error("AES multi-buffer: unsupported round count");
+    }
+}
+
+void cbcEncryptMultiBuffer(const CbcJob* jobs, size_t count, int rounds) {
+    switch (rounds) {
+        case 10: runCbc<10>(jobs, count); break;
+        case 12: runCbc<12>(jobs, count); break;
+        case 14: runCbc<14>(jobs, count); break;
+        default: throw std::runtime_error("AES multi-buffer: unsupported round count");
+    }
+}
+
+#else
+
+bool multiBufferSupported() {
+    return false;
+}
+
+void ctrMultiBuffer(const CtrJob*, size_t, int) {
+    throw std::runtime_error("AES multi-buffer kernel not built for this target");
+}
+
+void cbcEncryptMultiBuffer(const CbcJob*, size_t, int) {
+    throw std::runtime_error("AES multi-buffer kernel not built for this target");
+}
+
+#endif
+
+}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "kernels/aes_tables.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace hpc_benchmark {
+namespace aes {
+
+// Blocks kept in flight through the AES rounds at once. AES-NI has a
+// latency of several cycles per round but issues one round per cycle, so
+// a single short CTR stream leaves most of the pipeline idle.
+constexpr int MULTI_BUFFER_LANES = 8;
+
+// One CTR message for the multi-buffer kernel. roundKeys holds
+// (rounds + 1) * 16 bytes in AES-NI order (see roundKeyBytes); counter is
+// the initial 128-bit big-endian counter block.
+struct CtrJob {
+    const uint8_t* roundKeys;
+    const uint8_t* counter;
+    const uint8_t* input;
+    uint8_t* output;
+    size_t size;
+};
+
+// One CBC message for the multi-buffer encryptor: same schedule layout as
+// CtrJob, iv is the initial chaining value, size a multiple of 16.
+struct CbcJob {
+    const uint8_t* roundKeys;
+    const uint8_t* iv;
+    const uint8_t* input;
+    uint8_t* output;
+    size_t size;
+};
+
+// Expanded schedule as the byte stream AES-NI loads round keys from.
+template <int KeyBits>
+inline void roundKeyBytes(const uint8_t* key, uint8_t* out) {
+    uint32_t words[KeySize<KeyBits>::SCHEDULE_WORDS];
+    keyExpansion<KeyBits>(key, words);
+    for (int i = 0; i < KeySize<KeyBits>::SCHEDULE_WORDS; ++i) {
+        out[4*i] = static_cast<uint8_t>(words[i] >> 24);
+        out[4*i+1] = static_cast<uint8_t>(words[i] >> 16);
+        out[4*i+2] = static_cast<uint8_t>(words[i] >> 8);
+        out[4*i+3] = static_cast<uint8_t>(words[i]);
+    }
+}
+
+// True if this build has the AES-NI kernel and the CPU supports it.
+bool multiBufferSupported();
+
+// Encrypts every job, filling each pass of MULTI_BUFFER_LANES blocks from
+// the remaining blocks of the current job and the jobs after it, so many
+// short messages keep the pipeline as full as one long one. All jobs use
+// the same round count (10, 12 or 14).
+void ctrMultiBuffer(const CtrJob* jobs, size_t count, int rounds);
+
+// CBC encryption is serial within a message, so the lanes are messages:
+// each lane chains through one job block by block and takes the next
+// unstarted job when it finishes. A single job runs at one block per
+// round latency; MULTI_BUFFER_LANES or more jobs fill the pipeline.
+void cbcEncryptMultiBuffer(const CbcJob* jobs, size_t count, int rounds);
+
+}
+}
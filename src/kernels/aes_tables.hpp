@@ -45,25 +45,43 @@ inline uint32_t mul(uint32_t x, uint32_t y) {
 #define TE2(i) ((SBOX[i]) | (SBOX[i] << 8) | (mul(SBOX[i], 2) << 16) | (mul(SBOX[i], 3) << 24))
 #define TE3(i) ((mul(SBOX[i], 3)) | (SBOX[i] << 8) | (SBOX[i] << 16) | (mul(SBOX[i], 2) << 24))
 
-inline void keyExpansion256(const uint8_t* key, uint32_t* roundKeys) {
-    for (int i = 0; i < 8; ++i) {
+// FIPS-197 parameters per key size: Nk key words, Nr rounds and the
+// 4 * (Nr + 1) words of the expanded schedule.
+template <int KeyBits>
+struct KeySize {
+    static_assert(KeyBits == 128 || KeyBits == 192 || KeyBits == 256,
+                  "AES key size must be 128, 192 or 256 bits");
+    static constexpr int KEY_BYTES = KeyBits / 8;
+    static constexpr int NK = KeyBits / 32;
+    static constexpr int ROUNDS = NK + 6;
+    static constexpr int SCHEDULE_WORDS = 4 * (ROUNDS + 1);
+};
+
+template <int KeyBits>
+inline void keyExpansion(const uint8_t* key, uint32_t* roundKeys) {
+    constexpr int NK = KeySize<KeyBits>::NK;
+    constexpr int WORDS = KeySize<KeyBits>::SCHEDULE_WORDS;
+    
+    for (int i = 0; i < NK; ++i) {
         roundKeys[i] = (key[4*i] << 24) | (key[4*i+1] << 16) | (key[4*i+2] << 8) | key[4*i+3];
     }
     
-    for (int i = 8; i < 60; ++i) {
+    for (int i = NK; i < WORDS; ++i) {
         uint32_t temp = roundKeys[i - 1];
-        if (i % 8 == 0) {
+        if (i % NK == 0) {
             temp = ((SBOX[(temp >> 16) & 0xff] << 24) |
                     (SBOX[(temp >> 8) & 0xff] << 16) |
                     (SBOX[temp & 0xff] << 8) |
-                    SBOX[(temp >> 24) & 0xff]) ^ (RCON[i/8] << 24);
-        } else if (i % 8 == 4) {
-            temp = (SBOX[(temp >> 24) & 0xff] << 24) |
-                   (SBOX[(temp >> 16) & 0xff] << 16) |
-                   (SBOX[(temp >> 8) & 0xff] << 8) |
-                   SBOX[temp & 0xff];
+                    SBOX[(temp >> 24) & 0xff]) ^ (RCON[i/NK] << 24);
+        } else if constexpr (NK > 6) {
+            if (i % NK == 4) {
+                temp = (SBOX[(temp >> 24) & 0xff] << 24) |
+                       (SBOX[(temp >> 16) & 0xff] << 16) |
+                       (SBOX[(temp >> 8) & 0xff] << 8) |
+                       SBOX[temp & 0xff];
+            }
         }
-        roundKeys[i] = roundKeys[i - 8] ^ temp;
+        roundKeys[i] = roundKeys[i - NK] ^ temp;
     }
 }
 
@@ -73,5 +91,15 @@ inline void incrementCounter(uint8_t* counter) {
     }
 }
 
+inline void addCounter(uint8_t* counter, uint64_t blocks) {
+    unsigned carry = 0;
+    for (int i = 15; i >= 0 && (blocks > 0 || carry); --i) {
+        unsigned sum = counter[i] + static_cast<unsigned>(blocks & 0xff) + carry;
+        counter[i] = static_cast<uint8_t>(sum);
+        carry = sum >> 8;
+        blocks >>= 8;
+    }
+}
+
 }
 }
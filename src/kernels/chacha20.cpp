@@ -0,0 +1,233 @@
+#include "chacha20.hpp"
+#include "chacha20_simd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CHACHA_HAS_VECTOR 1
+#endif
+
+namespace hpc_benchmark {
+namespace chacha {
+
+namespace {
+
+#ifdef CHACHA_HAS_VECTOR
+// 4-lane kernel for the baseline target (SSE2 on x86-64, NEON on AArch64).
+#include "chacha20_simd.inl"
+#endif
+
+uint32_t load32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t rotl(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl(d, 16);
+    c += d; b ^= c; b = rotl(b, 12);
+    a += b; d ^= a; d = rotl(d, 8);
+    c += d; b ^= c; b = rotl(b, 7);
+}
+
+void block(const uint32_t* state, uint8_t* keystream) {
+    uint32_t x[16];
+    std::memcpy(x, state, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+        quarterRound(x[0], x[4], x[8], x[12]);
+        quarterRound(x[1], x[5], x[9], x[13]);
+        quarterRound(x[2], x[6], x[10], x[14]);
+        quarterRound(x[3], x[7], x[11], x[15]);
+        quarterRound(x[0], x[5], x[10], x[15]);
+        quarterRound(x[1], x[6], x[11], x[12]);
+        quarterRound(x[2], x[7], x[8], x[13]);
+        quarterRound(x[3], x[4], x[9], x[14]);
+    }
+    for (int w = 0; w < 16; ++w) {
+        uint32_t v = x[w] + state[w];
+        keystream[4 * w] = static_cast<uint8_t>(v);
+        keystream[4 * w + 1] = static_cast<uint8_t>(v >> 8);
+        keystream[4 * w + 2] = static_cast<uint8_t>(v >> 16);
+        keystream[4 * w + 3] = static_cast<uint8_t>(v >> 24);
+    }
+}
+
+void advance(uint32_t* state, uint64_t blocks) {
+    uint64_t counter = (static_cast<uint64_t>(state[13]) << 32 | state[12]) + blocks;
+    state[12] = static_cast<uint32_t>(counter);
+    state[13] = static_cast<uint32_t>(counter >> 32);
+}
+
+bool detect(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar:
+            return true;
+        case Isa::Sse:
+#ifdef CHACHA_HAS_VECTOR
+            return true;
+#else
+            return false;
+#endif
+        case Isa::Avx2:
+#if defined(HAS_CHACHA_AVX2) && defined(CHACHA_HAS_VECTOR)
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        case Isa::Avx512:
+#if defined(HAS_CHACHA_AVX512) && defined(CHACHA_HAS_VECTOR)
+            return __builtin_cpu_supports("avx512f");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+std::atomic<Isa>& active() {
+    static std::atomic<Isa> isa{bestIsa()};
+    return isa;
+}
+
+}
+
+const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::Sse: return "sse";
+        case Isa::Avx2: return "avx2";
+        case Isa::Avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+bool parseIsa(const std::string& name, Isa& isa) {
+    for (Isa candidate : {Isa::Scalar, Isa::Sse, Isa::Avx2, Isa::Avx512}) {
+        if (name == isaName(candidate)) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+int blocksPerPass(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return 1;
+        case Isa::Sse: return 4;
+        case Isa::Avx2: return 8;
+        case Isa::Avx512: return 16;
+    }
+    return 1;
+}
+
+bool isaSupported(Isa isa) {
+    return detect(isa);
+}
+
+Isa bestIsa() {
+    for (Isa isa : {Isa::Avx512, Isa::Avx2, Isa::Sse}) {
+        if (detect(isa)) return isa;
+    }
+    return Isa::Scalar;
+}
+
+Isa activeIsa() {
+    return active().load(std::memory_order_relaxed);
+}
+
+bool setActiveIsa(Isa isa) {
+    if (!detect(isa)) return false;
+    active().store(isa, std::memory_order_relaxed);
+    return true;
+}
+
+void addCounter(uint8_t* iv, uint64_t blocks) {
+    uint64_t counter = 0;
+    for (int i = 7; i >= 0; --i) counter = counter << 8 | iv[i];
+    counter += blocks;
+    for (int i = 0; i < 8; ++i) iv[i] = static_cast<uint8_t>(counter >> (8 * i));
+}
+
+void xorKeystream(const uint8_t* key, const uint8_t* iv,
+                  const uint8_t* in, uint8_t* out, size_t len) {
+    xorKeystream(key, iv, in, out, len, activeIsa());
+}
+
+void xorKeystream(const uint8_t* key, const uint8_t* iv,
+                  const uint8_t* in, uint8_t* out, size_t len, Isa isa) {
+    uint32_t state[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+    for (int i = 0; i < 8; ++i) state[4 + i] = load32(key + 4 * i);
+    for (int i = 0; i < 4; ++i) state[12 + i] = load32(iv + 4 * i);
+
+    uint8_t keystream[BLOCK_BYTES];
+    auto scalarBlocks = [&](size_t count) {
+        for (size_t b = 0; b < count && len > 0; ++b) {
+            block(state, keystream);
+            size_t n = std::min(len, BLOCK_BYTES);
+            for (size_t i = 0; i < n; ++i) out[i] = in[i] ^ keystream[i];
+            advance(state, 1);
+            in += n;
+            out += n;
+            len -= n;
+        }
+    };
+
+    // The widest kernel first, then each narrower one the CPU can run on
+    // what is left, so short messages and tails still use vector passes.
+    for (Isa kernel : {Isa::Avx512, Isa::Avx2, Isa::Sse}) {
+        const size_t lanes = static_cast<size_t>(blocksPerPass(kernel));
+        if (lanes > static_cast<size_t>(blocksPerPass(isa)) || !detect(kernel)) continue;
+        while (len / BLOCK_BYTES >= lanes) {
+            // A pass must not wrap the 32-bit counter word; the blocks up to the
+            // wrap go through the scalar path, which carries into word 13.
+            uint64_t untilWrap = (uint64_t(1) << 32) - state[12];
+            if (untilWrap < lanes) {
+                scalarBlocks(static_cast<size_t>(untilWrap));
+                continue;
+            }
+            size_t passes = static_cast<size_t>(std::min<uint64_t>(len / BLOCK_BYTES, untilWrap) / lanes);
+
+            switch (kernel) {
+#ifdef CHACHA_HAS_VECTOR
+                case Isa::Sse: xorPasses<4>(state, in, out, passes); break;
+#endif
+#ifdef HAS_CHACHA_AVX2
+                case Isa::Avx2: xorPassesAvx2(state, in, out, passes); break;
+#endif
+#ifdef HAS_CHACHA_AVX512
+                case Isa::Avx512: xorPassesAvx512(state, in, out, passes); break;
+#endif
+                default: passes = 0; break;
+            }
+            if (passes == 0) break;
+
+            size_t done = passes * lanes;
+            advance(state, done);
+            in += done * BLOCK_BYTES;
+            out += done * BLOCK_BYTES;
+            len -= done * BLOCK_BYTES;
+        }
+    }
+
+#ifdef CHACHA_HAS_VECTOR
+    // Fewer than 4 blocks but more than one: one padded 4-lane pass is
+    // cheaper than two or three scalar blocks.
+    if (isa != Isa::Scalar && len > BLOCK_BYTES && (uint64_t(1) << 32) - state[12] >= 4) {
+        uint8_t tail[4 * BLOCK_BYTES] = {};
+        std::memcpy(tail, in, len);
+        xorPasses<4>(state, tail, tail, 1);
+        std::memcpy(out, tail, len);
+        return;
+    }
+#endif
+
+    scalarBlocks(len / BLOCK_BYTES + 1);
+}
+
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hpc_benchmark {
+namespace chacha {
+
+constexpr size_t BLOCK_BYTES = 64;
+
+// Keystream kernels, by how many blocks one pass computes side by side:
+// Scalar 1, Sse 4 (128-bit lanes), Avx2 8, Avx512 16.
+enum class Isa {
+    Scalar,
+    Sse,
+    Avx2,
+    Avx512
+};
+
+const char* isaName(Isa isa);
+bool parseIsa(const std::string& name, Isa& isa);
+int blocksPerPass(Isa isa);
+
+// True if this build has the kernel and the CPU/OS can run it.
+bool isaSupported(Isa isa);
+Isa bestIsa();
+
+// Kernel used by every ChaCha20 engine: the best supported one unless
+// overridden. setActiveIsa() returns false and keeps the current kernel
+// if `isa` cannot run here.
+Isa activeIsa();
+bool setActiveIsa(Isa isa);
+
+// XORs len bytes of the ChaCha20 keystream into `in`. iv is the 16-byte
+// OpenSSL EVP_chacha20 layout: little-endian block counter in bytes 0-3,
+// 96-bit nonce in bytes 4-15. Like OpenSSL, a counter wrap carries into
+// the first nonce word, so bytes 0-7 act as one 64-bit block counter.
+void xorKeystream(const uint8_t* key, const uint8_t* iv,
+                  const uint8_t* in, uint8_t* out, size_t len);
+
+// Same, with the active kernel overridden for this call.
+void xorKeystream(const uint8_t* key, const uint8_t* iv,
+                  const uint8_t* in, uint8_t* out, size_t len, Isa isa);
+
+// Adds `blocks` to the 64-bit little-endian counter in iv bytes 0-7.
+void addCounter(uint8_t* iv, uint64_t blocks);
+
+}
+}
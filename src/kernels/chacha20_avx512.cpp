@@ -0,0 +1,18 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only reached after a runtime
+// CPU check.
+#include "chacha20_simd.hpp"
+#include <cstring>
+
+namespace hpc_benchmark {
+namespace chacha {
+
+namespace {
+#include "chacha20_simd.inl"
+}
+
+void xorPassesAvx512(const uint32_t* state, const uint8_t* in, uint8_t* out, size_t passes) {
+    xorPasses<16>(state, in, out, passes);
+}
+
+}
+}
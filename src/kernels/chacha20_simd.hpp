@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Entry points of the ISA-specific translation units. Each computes `passes`
+// x N blocks from `state` (whose counter word it leaves untouched) and XORs
+// them into in -> out; the caller keeps the counter from wrapping mid-pass.
+// Declarations only: anything inline here would be compiled with the wider
+// ISA flags and could leak into the baseline code through the linker.
+
+namespace hpc_benchmark {
+namespace chacha {
+
+void xorPassesAvx2(const uint32_t* state, const uint8_t* in, uint8_t* out, size_t passes);
+void xorPassesAvx512(const uint32_t* state, const uint8_t* in, uint8_t* out, size_t passes);
+
+}
+}
@@ -0,0 +1,71 @@
+// Multi-block ChaCha20 body shared by the per-ISA translation units.
+// Include inside an anonymous namespace after <cstring>; every lane of a
+// vector holds the same state word of a different block, so the 20 rounds
+// run LANES blocks at once and the keystream is transposed on the way out.
+
+template <int LANES> struct LaneVector;
+template <> struct LaneVector<4> { typedef uint32_t type __attribute__((vector_size(16))); };
+template <> struct LaneVector<8> { typedef uint32_t type __attribute__((vector_size(32))); };
+template <> struct LaneVector<16> { typedef uint32_t type __attribute__((vector_size(64))); };
+
+#define CHACHA_ROTL(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+#define CHACHA_QR(a, b, c, d)                  \
+    a += b; d ^= a; d = CHACHA_ROTL(d, 16);    \
+    c += d; b ^= c; b = CHACHA_ROTL(b, 12);    \
+    a += b; d ^= a; d = CHACHA_ROTL(d, 8);     \
+    c += d; b ^= c; b = CHACHA_ROTL(b, 7);
+
+template <int LANES>
+void xorPasses(const uint32_t* state, const uint8_t* in, uint8_t* out, size_t passes) {
+    typedef typename LaneVector<LANES>::type Vec;
+
+    Vec lane = {};
+    for (int i = 0; i < LANES; ++i) lane[i] = static_cast<uint32_t>(i);
+
+    Vec init[16];
+    for (int w = 0; w < 16; ++w) {
+        init[w] = Vec{} + state[w];
+    }
+    init[12] += lane;
+
+    alignas(64) uint32_t ks[16][LANES];
+
+    for (size_t p = 0; p < passes; ++p) {
+        Vec x[16];
+        for (int w = 0; w < 16; ++w) x[w] = init[w];
+
+        for (int round = 0; round < 10; ++round) {
+            CHACHA_QR(x[0], x[4], x[8], x[12])
+            CHACHA_QR(x[1], x[5], x[9], x[13])
+            CHACHA_QR(x[2], x[6], x[10], x[14])
+            CHACHA_QR(x[3], x[7], x[11], x[15])
+            CHACHA_QR(x[0], x[5], x[10], x[15])
+            CHACHA_QR(x[1], x[6], x[11], x[12])
+            CHACHA_QR(x[2], x[7], x[8], x[13])
+            CHACHA_QR(x[3], x[4], x[9], x[14])
+        }
+
+        for (int w = 0; w < 16; ++w) {
+            Vec v = x[w] + init[w];
+            std::memcpy(ks[w], &v, sizeof(v));
+        }
+
+        for (int j = 0; j < LANES; ++j) {
+            const uint8_t* src = in + j * 64;
+            uint8_t* dst = out + j * 64;
+            for (int w = 0; w < 16; ++w) {
+                uint32_t word;
+                std::memcpy(&word, src + 4 * w, 4);
+                word ^= ks[w][j];
+                std::memcpy(dst + 4 * w, &word, 4);
+            }
+        }
+
+        init[12] += static_cast<uint32_t>(LANES);
+        in += LANES * 64;
+        out += LANES * 64;
+    }
+}
+
+#undef CHACHA_QR
+#undef CHACHA_ROTL
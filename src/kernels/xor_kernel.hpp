@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpc_benchmark {
+namespace xorcipher {
+
+// output[i] = input[i] ^ key[i % keyLen] for i in [begin, end). The key
+// index is stepped rather than recomputed per byte. Every XOR engine uses
+// this loop, so their speedups compare thread counts, not kernels.
+inline void apply(const uint8_t* input, uint8_t* output, size_t begin, size_t end,
+                  const uint8_t* key, size_t keyLen) {
+    size_t k = begin % keyLen;
+    for (size_t i = begin; i < end; ++i) {
+        output[i] = input[i] ^ key[k];
+        if (++k == keyLen) k = 0;
+    }
+}
+
+}
+}
@@ -10,32 +10,47 @@
 #include <cstring>
 #include <map>
 #include <thread>
+#include <stdexcept>
 
 #include "common/timer.hpp"
 #include "common/csv_logger.hpp"
 #include "common/verification.hpp"
 #include "common/file_utils.hpp"
 #include "common/power_monitor.hpp"
+#include "common/statistics.hpp"
+#include "common/perf_counters.hpp"
+#include "common/bandwidth_probe.hpp"
+#include "common/cpu_topology.hpp"
+#include "common/tuning_cache.hpp"
+#include "common/result_comparison.hpp"
+#include "common/load_generator.hpp"
+#include "common/soak_test.hpp"
+#include "common/energy_search.hpp"
+#include "common/cache_sweep.hpp"
+#include "common/sector_io.hpp"
+#include "common/small_messages.hpp"
+#include "common/key_schedule_cache.hpp"
+#include "common/key_rotation.hpp"
+#include "common/evp_study.hpp"
+#include "common/stream_position.hpp"
+#include "kernels/chacha20.hpp"
 #include "engines/i_cipher_engine.hpp"
-
-#include "engines/xor/xor_sequential.hpp"
+#include "engines/engine_registry.hpp"
+#include "engines/dispatch_engine.hpp"
+#include "engines/split_engine.hpp"
+#include "engines/aes/aes_xts.hpp"
+#include "engines/aes/aes_multibuffer.hpp"
 #include "engines/aes/aes_sequential.hpp"
+#include "engines/aes/evp_usage.hpp"
+#include <openssl/crypto.h>
 
 #ifdef HAS_OPENMP
 #include "engines/xor/xor_openmp.hpp"
 #include "engines/aes/aes_openmp.hpp"
+#include "engines/chacha/chacha20_openmp.hpp"
 #include <omp.h>
 #endif
 
-#ifdef HAS_CUDA
-#include "engines/xor/xor_cuda.cuh"
-#include "engines/aes/aes_cuda.cuh"
-#endif
-
-#ifdef HAS_METAL
-#include "engines/xor/xor_metal.hpp"
-#include "engines/aes/aes_metal.hpp"
-#endif
 
 namespace hpc_benchmark
 {
@@ -44,10 +59,51 @@ namespace hpc_benchmark
     {
         std::vector<size_t> fileSizesMB = {1, 10, 100};
         int iterations = 3;
+        int warmupIterations = 1;
+        double targetCIPercent = 0;
+        int maxIterations = 50;
         bool verify = true;
+        size_t verifySamples = 0;
+        bool timeDecrypt = false;
         bool threadScaling = true;
+        bool showPhases = false;
+        bool perfCounters = false;
+        bool bandwidthProbe = true;
+        size_t probeMB = 64;
         std::string outputFile = "benchmark_results.csv";
         int maxThreads = 0;
+        std::vector<int> threadList;
+        int threadStep = 0;
+        std::vector<AffinityPolicy> affinityPolicies = {AffinityPolicy::None};
+        bool autotune = false;
+        std::string tuningFile;
+        bool dispatch = false;
+        std::vector<std::string> splitMembers;
+        std::string compareFile;
+        std::string compareReport;
+        double regressionThresholdPercent = 5.0;
+        std::vector<int> loadClients;
+        std::string loadEngine = "OpenMP";
+        std::string loadMix = "64K";
+        double loadRate = 0;
+        double loadDurationSec = 5;
+        int loadEngineThreads = 0;
+        double soakDurationSec = 0;
+        double sampleIntervalSec = 1.0;
+        double burstSec = 10;
+        std::string soakEngine = "OpenMP";
+        std::string soakAlgorithm;
+        bool energySearch = false;
+        bool cacheSweep = false;
+        size_t cacheSweepMaxMB = 512;
+        std::vector<int> keySizes = {256};
+        bool sectorIo = false;
+        size_t sectorIoDeviceMB = 64;
+        bool smallMessages = false;
+        size_t batchJobs = 64;
+        size_t keyPool = 1;
+        size_t keyRotationBytes = 0;
+        bool evpStudy = false;
     };
 
     void printUsage(const char *progName)
@@ -56,11 +112,56 @@ namespace hpc_benchmark
                   << "\nOptions:\n"
                   << "  --sizes <list>       Comma-separated file sizes in MB (default: 1,10,100)\n"
                   << "  --iterations <n>     Number of iterations per test (default: 3)\n"
+                  << "  --warmup <n>         Untimed warm-up iterations per test (default: 1)\n"
+                  << "  --target-ci <pct>    Iterate until the 95% CI of the median is within pct\n"
+                  << "  --max-iterations <n> Upper bound for --target-ci (default: 50)\n"
                   << "  --verify             Enable verification mode (default: on)\n"
                   << "  --no-verify          Disable verification mode\n"
+                  << "  --verify-sampled <n> Verify n random 4 KB ciphertext windows per test\n"
+                  << "  --time-decrypt       Also time decryption and report it per engine (always on for CBC)\n"
                   << "  --thread-scaling     Enable thread scaling tests (default: on)\n"
                   << "  --no-thread-scaling  Disable thread scaling tests\n"
                   << "  --max-threads <n>    Maximum threads for scaling tests (default: auto)\n"
+                  << "  --threads <list>     Explicit comma-separated thread counts for scaling tests\n"
+                  << "  --thread-step <n>    Thread counts 1, n, 2n, ... up to --max-threads\n"
+                  << "  --affinity <list>    Pinning policies: none,compact,scatter,physical (default: none)\n"
+                  << "  --phases             Print per-engine phase timing breakdown\n"
+                  << "  --perf-counters      Collect hardware counters via perf_event_open (Linux)\n"
+                  << "  --no-bandwidth-probe Skip the startup STREAM-style bandwidth probe\n"
+                  << "  --probe-mb <n>       Array size in MB for the bandwidth probe (default: 64)\n"
+                  << "  --key-sizes <list>   AES key sizes in bits: 128,192,256 (default: 256)\n"
+                  << "  --chacha-kernel <k>  ChaCha20 kernel: scalar, sse, avx2, avx512 (default: best supported)\n"
+                  << "  --autotune           Search OpenMP chunk size, schedule and threads per size, then exit\n"
+                  << "  --tuning-file <file> Tuning cache to load/save (default: ~/.cache/hpc_benchmark/tuning-<host>.txt)\n"
+                  << "  --dispatch           Also run the size-routing dispatcher per algorithm\n"
+                  << "  --split <engines>    Also run one buffer split across engines, e.g. OpenMP,Sequential\n"
+                  << "  --duration <s>       Soak mode: encrypt continuously for s seconds per algorithm, then exit\n"
+                  << "  --sample-interval <ms> Soak sampling interval (default: 1000)\n"
+                  << "  --burst <s>          Initial seconds reported as burst, not steady state (default: 10)\n"
+                  << "  --soak-engine <name> Engine for soak mode (default: OpenMP)\n"
+                  << "  --soak-algorithm <a> Restrict soak mode to one algorithm\n"
+                  << "  --energy-search      Sweep threads, --affinity and chunk sizes for J/GB, report Pareto frontier, then exit\n"
+                  << "  --cache-sweep        Sweep byte-level sizes around the L1/L2/LLC capacities, warm and flushed, then exit\n"
+                  << "  --cache-sweep-max <MB> Largest working set (input + output) for the cache sweep (default: 512)\n"
+                  << "  --sector-size <bytes> AES-XTS sector size, 16 B - 16 MiB (default: 4096)\n"
+                  << "  --sector-io          Random and sequential sector-sized I/O against a simulated device, then exit\n"
+                  << "  --sector-io-device <MB> Simulated device size for --sector-io (default: 64)\n"
+                  << "  --small-messages     64 B - 4 KB messages per engine, encrypt() per message vs encryptBatch(), then exit\n"
+                  << "  --batch-jobs <n>     Messages per batch for --small-messages (default: 64)\n"
+                  << "  --key-pool <n>       Distinct keys the --small-messages jobs rotate through (default: 1)\n"
+                  << "  --key-cache <n>      Cache up to n expanded key schedules/contexts across calls (default: 0 = off)\n"
+                  << "  --key-rotation <bytes> Stream the largest --sizes under a new key every bytes (e.g. 64K, 1G), inline vs prefetched re-keying, then exit\n"
+                  << "  --evp-usage <f[/c]>  AES-CTR EVP usage: fetch implicit|process|libctx, context fresh|reset (default: implicit)\n"
+                  << "  --evp-study          Every --evp-usage variant: per-message cost and OpenMP setup time per thread count, then exit\n"
+                  << "  --compare <csv>      Compare results against a baseline CSV; exit 2 on regression\n"
+                  << "  --regression-threshold <pct> Change needed to flag a regression (default: 5)\n"
+                  << "  --compare-report <f> JSON report path (default: <output>_compare.json)\n"
+                  << "  --load <list>        Concurrent load test with these client counts, then exit\n"
+                  << "  --load-engine <name> Engine per client (default: OpenMP)\n"
+                  << "  --load-mix <spec>    Payload sizes, e.g. 4K:0.7,64K:0.2,1M:0.1 (default: 64K)\n"
+                  << "  --load-rate <n>      Open-loop requests/s per client (default: 0 = closed loop)\n"
+                  << "  --load-duration <s>  Seconds per load run (default: 5)\n"
+                  << "  --load-engine-threads <n> Threads per client engine (default: all)\n"
                   << "  --output <file>      CSV output file (default: benchmark_results.csv)\n"
                   << "  --help               Show this help message\n";
     }
@@ -124,9 +225,27 @@ namespace hpc_benchmark
             {
                 config.iterations = std::stoi(argv[++i]);
             }
+            else if (arg == "--warmup" && i + 1 < argc)
+            {
+                config.warmupIterations = std::stoi(argv[++i]);
+            }
+            else if (arg == "--target-ci" && i + 1 < argc)
+            {
+                config.targetCIPercent = std::stod(argv[++i]);
+            }
+            else if (arg == "--max-iterations" && i + 1 < argc)
+            {
+                config.maxIterations = std::stoi(argv[++i]);
+            }
             else if (arg == "--verify")
             {
                 config.verify = true;
+                config.verifySamples = 0;
+            }
+            else if (arg == "--verify-sampled" && i + 1 < argc)
+            {
+                config.verify = true;
+                config.verifySamples = std::stoul(argv[++i]);
             }
             else if (arg == "--no-verify")
             {
@@ -144,6 +263,219 @@ namespace hpc_benchmark
             {
                 config.maxThreads = std::stoi(argv[++i]);
             }
+            else if (arg == "--threads" && i + 1 < argc)
+            {
+                config.threadList.clear();
+                for (size_t t : parseSizes(argv[++i]))
+                    config.threadList.push_back(static_cast<int>(t));
+            }
+            else if (arg == "--thread-step" && i + 1 < argc)
+            {
+                config.threadStep = std::stoi(argv[++i]);
+            }
+            else if (arg == "--affinity" && i + 1 < argc)
+            {
+                config.affinityPolicies.clear();
+                std::stringstream ss(argv[++i]);
+                std::string name;
+                while (std::getline(ss, name, ','))
+                    config.affinityPolicies.push_back(parseAffinityPolicy(name));
+            }
+            else if (arg == "--phases")
+            {
+                config.showPhases = true;
+            }
+            else if (arg == "--perf-counters")
+            {
+                config.perfCounters = true;
+            }
+            else if (arg == "--bandwidth-probe")
+            {
+                config.bandwidthProbe = true;
+            }
+            else if (arg == "--no-bandwidth-probe")
+            {
+                config.bandwidthProbe = false;
+            }
+            else if (arg == "--probe-mb" && i + 1 < argc)
+            {
+                config.probeMB = std::stoul(argv[++i]);
+            }
+            else if (arg == "--key-sizes" && i + 1 < argc)
+            {
+                config.keySizes.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                {
+                    int bits = 0;
+                    try
+                    {
+                        size_t used = 0;
+                        bits = std::stoi(token, &used);
+                        if (used != token.size())
+                            bits = 0;
+                    }
+                    catch (const std::logic_error &)
+                    {
+                    }
+                    if (bits != 128 && bits != 192 && bits != 256)
+                        throw std::runtime_error("AES key size must be 128, 192 or 256: " + token);
+                    config.keySizes.push_back(bits);
+                }
+            }
+            else if (arg == "--chacha-kernel" && i + 1 < argc)
+            {
+                std::string name = argv[++i];
+                chacha::Isa isa;
+                if (!chacha::parseIsa(name, isa))
+                    throw std::runtime_error("Unknown ChaCha20 kernel: " + name +
+                                             " (expected scalar, sse, avx2 or avx512)");
+                if (!chacha::setActiveIsa(isa))
+                    throw std::runtime_error("ChaCha20 kernel not available on this host: " + name);
+            }
+            else if (arg == "--autotune")
+            {
+                config.autotune = true;
+            }
+            else if (arg == "--tuning-file" && i + 1 < argc)
+            {
+                config.tuningFile = argv[++i];
+            }
+            else if (arg == "--dispatch")
+            {
+                config.dispatch = true;
+            }
+            else if (arg == "--split" && i + 1 < argc)
+            {
+                config.splitMembers.clear();
+                std::stringstream ss(argv[++i]);
+                std::string name;
+                while (std::getline(ss, name, ','))
+                    config.splitMembers.push_back(name);
+            }
+            else if (arg == "--duration" && i + 1 < argc)
+            {
+                config.soakDurationSec = std::stod(argv[++i]);
+            }
+            else if (arg == "--sample-interval" && i + 1 < argc)
+            {
+                config.sampleIntervalSec = std::stod(argv[++i]) / 1000.0;
+            }
+            else if (arg == "--burst" && i + 1 < argc)
+            {
+                config.burstSec = std::stod(argv[++i]);
+            }
+            else if (arg == "--soak-engine" && i + 1 < argc)
+            {
+                config.soakEngine = argv[++i];
+            }
+            else if (arg == "--soak-algorithm" && i + 1 < argc)
+            {
+                config.soakAlgorithm = argv[++i];
+            }
+            else if (arg == "--energy-search")
+            {
+                config.energySearch = true;
+            }
+            else if (arg == "--cache-sweep")
+            {
+                config.cacheSweep = true;
+            }
+            else if (arg == "--cache-sweep-max" && i + 1 < argc)
+            {
+                config.cacheSweepMaxMB = std::stoul(argv[++i]);
+            }
+            else if (arg == "--sector-size" && i + 1 < argc)
+            {
+                AesXtsEngine::setDefaultSectorBytes(std::stoul(argv[++i]));
+            }
+            else if (arg == "--sector-io")
+            {
+                config.sectorIo = true;
+            }
+            else if (arg == "--sector-io-device" && i + 1 < argc)
+            {
+                config.sectorIoDeviceMB = std::stoul(argv[++i]);
+            }
+            else if (arg == "--time-decrypt")
+            {
+                config.timeDecrypt = true;
+            }
+            else if (arg == "--small-messages")
+            {
+                config.smallMessages = true;
+            }
+            else if (arg == "--batch-jobs" && i + 1 < argc)
+            {
+                config.batchJobs = std::max<size_t>(1, std::stoul(argv[++i]));
+            }
+            else if (arg == "--key-pool" && i + 1 < argc)
+            {
+                config.keyPool = std::max<size_t>(1, std::stoul(argv[++i]));
+            }
+            else if (arg == "--key-rotation" && i + 1 < argc)
+            {
+                config.keyRotationBytes = parseByteSize(argv[++i]);
+            }
+            else if (arg == "--evp-usage" && i + 1 < argc)
+            {
+                std::string text = argv[++i];
+                EvpFetch fetch;
+                std::optional<EvpContext> context;
+                if (!parseEvpUsage(text, fetch, context))
+                    throw std::runtime_error("Bad --evp-usage: " + text +
+                                             " (expected implicit|process|libctx, optionally /fresh or /reset)");
+                setDefaultEvpUsage(fetch, context);
+            }
+            else if (arg == "--evp-study")
+            {
+                config.evpStudy = true;
+            }
+            else if (arg == "--key-cache" && i + 1 < argc)
+            {
+                KeyScheduleCache::shared().setCapacity(std::stoul(argv[++i]));
+            }
+            else if (arg == "--compare" && i + 1 < argc)
+            {
+                config.compareFile = argv[++i];
+            }
+            else if (arg == "--regression-threshold" && i + 1 < argc)
+            {
+                config.regressionThresholdPercent = std::stod(argv[++i]);
+            }
+            else if (arg == "--compare-report" && i + 1 < argc)
+            {
+                config.compareReport = argv[++i];
+            }
+            else if (arg == "--load" && i + 1 < argc)
+            {
+                config.loadClients.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                    config.loadClients.push_back(std::stoi(token));
+            }
+            else if (arg == "--load-engine" && i + 1 < argc)
+            {
+                config.loadEngine = argv[++i];
+            }
+            else if (arg == "--load-mix" && i + 1 < argc)
+            {
+                config.loadMix = argv[++i];
+            }
+            else if (arg == "--load-rate" && i + 1 < argc)
+            {
+                config.loadRate = std::stod(argv[++i]);
+            }
+            else if (arg == "--load-duration" && i + 1 < argc)
+            {
+                config.loadDurationSec = std::stod(argv[++i]);
+            }
+            else if (arg == "--load-engine-threads" && i + 1 < argc)
+            {
+                config.loadEngineThreads = std::stoi(argv[++i]);
+            }
             else if (arg == "--output" && i + 1 < argc)
             {
                 config.outputFile = argv[++i];
@@ -152,13 +484,32 @@ namespace hpc_benchmark
         return true;
     }
 
+    // Fixed-key algorithms always run; AES variants only for --key-sizes.
+    bool keySizeSelected(const Config &config, const EngineCapabilities &caps)
+    {
+        return caps.keyBits == 0 ||
+               std::find(config.keySizes.begin(), config.keySizes.end(), caps.keyBits) != config.keySizes.end();
+    }
+
+    std::vector<std::string> selectedAlgorithms(const Config &config)
+    {
+        const EngineRegistry &registry = EngineRegistry::instance();
+        std::vector<std::string> result;
+        for (const auto &algorithm : registry.algorithms())
+        {
+            if (keySizeSelected(config, registry.forAlgorithm(algorithm).front()->caps))
+                result.push_back(algorithm);
+        }
+        return result;
+    }
+
     void printHeader()
     {
         std::cout << "\n";
         std::cout << "╔════════════════════════════════════════════════════════════════════╗\n";
         std::cout << "║       HPC ENCRYPTION BENCHMARK - File Encryption Analysis          ║\n";
         std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
-        std::cout << "║  Algorithms: XOR (Memory-bound), AES-256-CTR (Compute-bound)       ║\n";
+        std::cout << "║  Algorithms: XOR (Memory-bound), AES-256-CTR, ChaCha20 (Compute)   ║\n";
         std::cout << "╚════════════════════════════════════════════════════════════════════╝\n\n";
     }
 
@@ -174,59 +525,94 @@ namespace hpc_benchmark
 #endif
 
         std::cout << "  CPU Threads: " << std::thread::hardware_concurrency() << "\n";
+        chacha::Isa chachaIsa = chacha::activeIsa();
+        std::cout << "  ChaCha20 Kernel: " << chacha::isaName(chachaIsa) << " (" << chacha::blocksPerPass(chachaIsa)
+                  << " block" << (chacha::blocksPerPass(chachaIsa) > 1 ? "s" : "") << "/pass)\n";
         std::cout << "  Available Engines:\n";
-        std::cout << "    ✓ Sequential (CPU)\n";
-
-#ifdef HAS_OPENMP
-        std::cout << "    ✓ OpenMP (CPU parallel)\n";
-#endif
-
-#ifdef HAS_CUDA
-        std::cout << "    ✓ CUDA (NVIDIA GPU)\n";
-#endif
-
-#ifdef HAS_METAL
-        std::cout << "    ✓ Metal (Apple GPU)\n";
-#endif
+        for (const auto &desc : EngineRegistry::instance().all())
+        {
+            if (!keySizeSelected(config, desc.caps))
+                continue;
+            std::cout << "    ✓ " << std::left << std::setw(20) << desc.caps.algorithm << std::setw(11) << desc.caps.engine
+                      << (desc.caps.accelerator ? "GPU" : desc.caps.threadControl ? "CPU parallel" : "CPU")
+                      << std::right << "\n";
+        }
 
         std::cout << "\n";
     }
 
+    CipherEnginePtr makeReferenceEngine(const std::string &algorithm)
+    {
+        return EngineRegistry::instance().create(algorithm, "Sequential");
+    }
+
     BenchmarkResult runSingleBenchmark(ICipherEngine *engine,
                                        const std::vector<uint8_t> &data,
                                        const std::vector<uint8_t> &key,
                                        const std::vector<uint8_t> &iv,
                                        bool verify,
+                                       size_t verifySamples,
                                        PowerMonitor &powerMonitor,
-                                       int numThreads = 1)
+                                       PerfCounters *perfCounters,
+                                       int numThreads = 1,
+                                       bool timeDecrypt = false)
     {
         BenchmarkResult result;
         result.algorithm = engine->getAlgorithmName();
         result.engine = engine->getEngineName();
         result.fileSizeMB = data.size() / (1024 * 1024);
         result.numThreads = numThreads;
+        result.keyBits = static_cast<int>(engine->getKeyBytes() * 8);
+        const size_t keyLen = engine->getKeyBytes();
 
         std::vector<uint8_t> encrypted(data.size());
         std::vector<uint8_t> decrypted(data.size());
 
         Timer timer;
+        engine->setPhaseRecorder(&result.phases);
         powerMonitor.startMeasurement();
+        if (perfCounters)
+            perfCounters->start();
         timer.start();
         engine->encrypt(data.data(), encrypted.data(), data.size(),
-                        key.data(), key.size(), iv.data());
+                        key.data(), keyLen, iv.data());
         timer.stop();
+        if (perfCounters)
+            result.counters = perfCounters->stop();
         auto energyReading = powerMonitor.stopMeasurement();
+        engine->setPhaseRecorder(nullptr);
 
         result.timeSec = timer.elapsedSeconds();
         result.throughputMBs = static_cast<double>(result.fileSizeMB) / result.timeSec;
         result.energyJoules = energyReading.joules;
         result.powerWatts = energyReading.watts;
         result.energySource = energyReading.source;
+        result.energyDomains = energyReading.domains;
 
-        if (verify)
+        // Timed outside the power and counter window, which belongs to
+        // encryption; the plaintext doubles as the verification round trip.
+        if (timeDecrypt)
         {
+            timer.start();
             engine->decrypt(encrypted.data(), decrypted.data(), data.size(),
-                            key.data(), key.size(), iv.data());
+                            key.data(), keyLen, iv.data());
+            timer.stop();
+            result.decryptTimeSec = timer.elapsedSeconds();
+        }
+
+        // Authenticated streams cannot be verified window by window; they
+        // fall back to a full round trip, which also checks the tags.
+        if (verify && verifySamples > 0 && isSeekable(result.algorithm))
+        {
+            auto reference = makeReferenceEngine(result.algorithm);
+            result.verified = verifySampledWindows(*reference, data.data(), encrypted.data(), data.size(),
+                                                   key.data(), keyLen, iv.data(), verifySamples);
+        }
+        else if (verify)
+        {
+            if (!timeDecrypt)
+                engine->decrypt(encrypted.data(), decrypted.data(), data.size(),
+                                key.data(), keyLen, iv.data());
             result.verified = verifyBuffers(data.data(), decrypted.data(), data.size());
         }
         else
@@ -241,35 +627,63 @@ namespace hpc_benchmark
                                         const std::vector<uint8_t> &chunkData,
                                         const std::vector<uint8_t> &key,
                                         const std::vector<uint8_t> &iv,
-                                        bool verify,
+                                        const Config &config,
                                         PowerMonitor &powerMonitor,
-                                        int iterations,
+                                        PerfCounters *perfCounters,
                                         int numThreads,
                                         size_t totalSizeMB,
                                         size_t numChunks,
-                                        double baselineTime)
+                                        double baselineTime,
+                                        double baselineDecryptTime = 0)
     {
-        double totalTime = 0;
+        const bool timeDecrypt = config.timeDecrypt || isCbcMode(engine->getAlgorithmName());
         double totalEnergy = 0;
         double totalPower = 0;
         bool allVerified = true;
         std::string energySrc;
+        std::vector<double> samples;
+        std::vector<double> decryptSamples;
+        PhaseTimings totalPhases;
+        HardwareCounters totalCounters;
+        DomainEnergy totalDomains;
+
+        for (int w = 0; w < config.warmupIterations; ++w)
+        {
+            runSingleBenchmark(engine, chunkData, key, iv, false, 0, powerMonitor, nullptr, numThreads);
+        }
 
-        size_t chunkSizeMB = chunkData.size() / (1024 * 1024);
+        // At least one measured iteration, so every statistic below exists.
+        const int iterations = std::max(1, config.iterations);
+        int maxIterations = config.targetCIPercent > 0 ? std::max(config.maxIterations, iterations) : iterations;
 
-        for (int iter = 0; iter < iterations; ++iter)
+        for (int iter = 0; iter < maxIterations; ++iter)
         {
+            if (iter >= iterations)
+            {
+                SampleStats stats = computeStats(samples);
+                if (relativeCIHalfWidth(stats) * 100.0 <= config.targetCIPercent)
+                {
+                    break;
+                }
+            }
+
             double iterTime = 0;
+            double iterDecryptTime = 0;
             double iterEnergy = 0;
             double iterPower = 0;
 
             for (size_t c = 0; c < numChunks; ++c)
             {
                 auto result = runSingleBenchmark(engine, chunkData, key, iv,
-                                                 (verify && c == 0), powerMonitor, numThreads);
+                                                 (config.verify && iter == 0 && c == 0), config.verifySamples,
+                                                 powerMonitor, perfCounters, numThreads, timeDecrypt);
                 iterTime += result.timeSec;
+                iterDecryptTime += result.decryptTimeSec;
                 iterEnergy += result.energyJoules;
                 iterPower += result.powerWatts;
+                totalPhases += result.phases;
+                totalCounters += result.counters;
+                totalDomains += result.energyDomains;
                 if (c == 0)
                 {
                     allVerified = allVerified && result.verified;
@@ -277,27 +691,49 @@ namespace hpc_benchmark
                 }
             }
 
-            totalTime += iterTime;
+            samples.push_back(iterTime);
+            if (timeDecrypt)
+                decryptSamples.push_back(iterDecryptTime);
             totalEnergy += iterEnergy;
             totalPower += iterPower / numChunks;
         }
 
+        SampleStats stats = computeStats(samples);
+        size_t measured = samples.size();
+
         BenchmarkResult avgResult;
         avgResult.platform = getPlatformName();
         avgResult.algorithm = engine->getAlgorithmName();
         avgResult.engine = engine->getEngineName();
         avgResult.fileSizeMB = totalSizeMB;
         avgResult.numThreads = numThreads;
-        avgResult.timeSec = totalTime / iterations;
-        avgResult.throughputMBs = static_cast<double>(totalSizeMB) / avgResult.timeSec;
+        avgResult.keyBits = static_cast<int>(engine->getKeyBytes() * 8);
+        // Time, throughput and speedup all come from the median, which one
+        // slow iteration cannot drag the way it drags the mean.
+        avgResult.timeSec = stats.median;
+        avgResult.throughputMBs = static_cast<double>(totalSizeMB) / stats.median;
         avgResult.verified = allVerified;
-        avgResult.energyJoules = totalEnergy / iterations;
-        avgResult.powerWatts = totalPower / iterations;
+        avgResult.energyJoules = totalEnergy / measured;
+        avgResult.powerWatts = totalPower / measured;
         avgResult.energySource = energySrc;
+        avgResult.energyDomains = totalDomains;
+        avgResult.energyDomains /= static_cast<double>(measured);
+        avgResult.warmupIterations = config.warmupIterations;
+        avgResult.timeSamples = samples;
+        avgResult.timeMedianSec = stats.median;
+        avgResult.timeMinSec = stats.min;
+        avgResult.timeP95Sec = stats.p95;
+        avgResult.timeStddevSec = stats.stddev;
+        avgResult.timeCILowSec = stats.ciLow;
+        avgResult.timeCIHighSec = stats.ciHigh;
+        avgResult.phases = totalPhases;
+        avgResult.phases /= static_cast<double>(measured);
+        avgResult.counters = totalCounters;
+        avgResult.counters /= static_cast<double>(measured);
 
         if (baselineTime > 0)
         {
-            avgResult.speedup = baselineTime / avgResult.timeSec;
+            avgResult.speedup = baselineTime / avgResult.timeMedianSec;
             avgResult.efficiency = avgResult.speedup / numThreads;
         }
         else
@@ -306,6 +742,15 @@ namespace hpc_benchmark
             avgResult.efficiency = 1.0;
         }
 
+        if (!decryptSamples.empty())
+        {
+            SampleStats decryptStats = computeStats(decryptSamples);
+            avgResult.decryptTimeSec = decryptStats.median;
+            avgResult.decryptTimeMedianSec = decryptStats.median;
+            avgResult.decryptThroughputMBs = static_cast<double>(totalSizeMB) / decryptStats.median;
+            avgResult.decryptSpeedup = baselineDecryptTime > 0 ? baselineDecryptTime / decryptStats.median : 1.0;
+        }
+
         return avgResult;
     }
 
@@ -315,7 +760,7 @@ namespace hpc_benchmark
                   << " | " << std::setw(10) << result.engine
                   << " | " << std::setw(3) << result.numThreads
                   << " | " << std::fixed << std::setprecision(2) << std::setw(12) << result.throughputMBs << " MB/s"
-                  << " | " << std::setw(8) << result.timeSec << " s"
+                  << " | " << std::setw(8) << result.timeMedianSec << " s"
                   << " | " << std::setw(6) << result.speedup;
 
         if (showEfficiency)
@@ -327,241 +772,1496 @@ namespace hpc_benchmark
             std::cout << " | " << std::setw(9) << "-";
         }
 
+        if (result.attainableBandwidthGBs > 0)
+        {
+            std::cout << " | " << std::setw(6) << (result.bandwidthUtilization * 100) << "%";
+        }
+        else
+        {
+            std::cout << " | " << std::setw(6) << "-";
+        }
+
+        double ciPct = result.timeMedianSec > 0
+                           ? (result.timeCIHighSec - result.timeCILowSec) / 2.0 / result.timeMedianSec * 100.0
+                           : 0;
+
         std::cout << " | " << std::setw(6) << result.powerWatts << " W"
+                  << " | ±" << std::setw(5) << ciPct << "%"
                   << " | " << (result.verified ? "PASS" : "FAIL") << "\n";
     }
 
-    void runBenchmarks(const Config &config)
+    void printPhaseLine(const BenchmarkResult &result)
     {
-        PowerMonitor powerMonitor;
+        double total = result.phases.total();
+        if (total <= 0)
+            return;
 
-        std::cout << "Test Configuration:\n";
-        std::cout << "───────────────────\n";
-        std::cout << "  File sizes: ";
-        for (size_t i = 0; i < config.fileSizesMB.size(); ++i)
+        std::cout << "      phases:";
+        for (size_t i = 0; i < PHASE_COUNT; ++i)
         {
-            std::cout << config.fileSizesMB[i] << " MB";
-            if (i < config.fileSizesMB.size() - 1)
-                std::cout << ", ";
+            double sec = result.phases.seconds[i];
+            if (sec <= 0)
+                continue;
+            std::cout << " " << phaseName(static_cast<Phase>(i)) << " "
+                      << std::fixed << std::setprecision(3) << sec * 1000 << " ms ("
+                      << std::setprecision(1) << sec / total * 100 << "%)";
         }
         std::cout << "\n";
-        std::cout << "  Iterations: " << config.iterations << "\n";
-        std::cout << "  Verification: " << (config.verify ? "enabled" : "disabled") << "\n";
-        std::cout << "  Thread Scaling: " << (config.threadScaling ? "enabled" : "disabled") << "\n";
-        std::cout << "  Max Threads: " << config.maxThreads << "\n";
-        std::cout << "  Power Monitoring: " << (powerMonitor.isAvailable() ? powerMonitor.getSource() : "N/A") << "\n";
-        std::cout << "  Output: " << config.outputFile << "\n\n";
+    }
 
-        CsvLogger logger(config.outputFile);
-        logger.writeHeader();
+    void printDecryptLine(const BenchmarkResult &result)
+    {
+        if (result.decryptTimeMedianSec <= 0)
+            return;
 
-        std::vector<uint8_t> key(32);
-        std::vector<uint8_t> iv(16);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, 255);
-        for (auto &b : key)
-            b = static_cast<uint8_t>(dis(gen));
-        for (auto &b : iv)
-            b = static_cast<uint8_t>(dis(gen));
+        std::cout << "      decrypt: " << std::fixed << std::setprecision(2) << result.decryptThroughputMBs << " MB/s"
+                  << " | " << result.decryptTimeMedianSec << " s"
+                  << " | speedup " << result.decryptSpeedup
+                  << " | " << result.timeMedianSec / result.decryptTimeMedianSec << "x encrypt rate\n";
+    }
 
-        std::vector<int> threadCounts;
-        if (config.threadScaling)
+    void printCounterLine(const BenchmarkResult &result)
+    {
+        const HardwareCounters &hw = result.counters;
+        if (!hw.any())
+            return;
+
+        double bytes = static_cast<double>(result.fileSizeMB) * 1024 * 1024;
+        std::cout << "      counters: IPC " << std::fixed << std::setprecision(2) << hw.ipc()
+                  << " | " << std::setprecision(3) << hw.cyclesPerByte(bytes) << " cycles/B";
+        if (hw.has(HwEvent::LlcMisses))
+            std::cout << " | " << std::setprecision(0) << hw.bytesPerLlcMiss(bytes) << " B/LLC-miss";
+        if (hw.has(HwEvent::DtlbMisses))
+            std::cout << " | dTLB " << std::setprecision(0) << hw.get(HwEvent::DtlbMisses);
+        if (hw.has(HwEvent::BranchMisses))
+            std::cout << " | br-miss " << std::setprecision(0) << hw.get(HwEvent::BranchMisses);
+        std::cout << "\n";
+    }
+
+    struct ReportContext
+    {
+        const Config &config;
+        CsvLogger &logger;
+        const BandwidthProfile *bandwidth;
+        int passed = 0;
+        int failed = 0;
+        std::map<std::string, double> bestThroughput; // "algorithm/engine" -> MB/s, per file size
+    };
+
+    // Effective traffic (one read, one write) against what the probe reached
+    // with the same thread count: the Xor kernel for the XOR engines, which
+    // move data the same way, Copy for the ciphers.
+    void applyBandwidth(BenchmarkResult &result, const BandwidthProfile &profile)
+    {
+        if (result.timeMedianSec <= 0)
+            return;
+
+        double bytesMoved = 2.0 * static_cast<double>(result.fileSizeMB) * 1024 * 1024;
+        result.effectiveBandwidthGBs = bytesMoved / result.timeMedianSec / 1e9;
+        StreamKernel kernel = result.algorithm == "XOR" ? StreamKernel::Xor : StreamKernel::Copy;
+        result.attainableBandwidthGBs = profile.at(std::max(1, result.numThreads), kernel);
+        if (result.attainableBandwidthGBs > 0)
+            result.bandwidthUtilization = result.effectiveBandwidthGBs / result.attainableBandwidthGBs;
+    }
+
+    void reportResult(BenchmarkResult &result, bool showEfficiency, ReportContext &ctx)
+    {
+        if (ctx.bandwidth)
+            applyBandwidth(result, *ctx.bandwidth);
+
+        printResultLine(result, showEfficiency);
+        printDecryptLine(result);
+        if (ctx.config.showPhases)
+            printPhaseLine(result);
+        if (ctx.config.perfCounters)
+            printCounterLine(result);
+        ctx.logger.writeResult(result);
+        double &best = ctx.bestThroughput[result.algorithm + "/" + result.engine];
+        best = std::max(best, result.throughputMBs);
+        if (result.verified)
+            ctx.passed++;
+        else
+            ctx.failed++;
+    }
+
+    void printBandwidthProfile(const BandwidthProfile &profile)
+    {
+        std::cout << "Memory Bandwidth Probe (GB/s, best of 5):\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Thr  |    Copy |   Scale |   Triad |     Xor\n";
+        for (const auto &sample : profile.samples)
         {
-            for (int t = 1; t <= config.maxThreads; t *= 2)
+            std::cout << "  " << std::left << std::setw(4) << sample.threads << std::right;
+            for (size_t k = 0; k < STREAM_KERNEL_COUNT; ++k)
             {
-                threadCounts.push_back(t);
+                std::cout << " | " << std::fixed << std::setprecision(2) << std::setw(7) << sample.gbs[k];
             }
-            if (threadCounts.back() != config.maxThreads)
+            std::cout << "\n";
+        }
+        std::cout << std::left << "  Attainable (read+write peak): "
+                  << std::max(profile.peak(StreamKernel::Copy), profile.peak(StreamKernel::Xor)) << " GB/s\n\n";
+    }
+
+    std::vector<int> buildThreadCounts(const Config &config)
+    {
+        std::vector<int> threadCounts;
+        if (!config.threadList.empty())
+        {
+            return config.threadList;
+        }
+
+        if (!config.threadScaling)
+        {
+            threadCounts.push_back(config.maxThreads);
+        }
+        else if (config.threadStep > 0)
+        {
+            threadCounts.push_back(1);
+            for (int t = config.threadStep; t <= config.maxThreads; t += config.threadStep)
             {
-                threadCounts.push_back(config.maxThreads);
+                if (t != 1)
+                    threadCounts.push_back(t);
             }
         }
         else
         {
-            threadCounts.push_back(config.maxThreads);
+            for (int t = 1; t <= config.maxThreads; t *= 2)
+            {
+                threadCounts.push_back(t);
+            }
         }
 
-        int totalPassed = 0;
-        int totalFailed = 0;
-
-        for (size_t sizeMB : config.fileSizesMB)
+        if (threadCounts.back() != config.maxThreads)
         {
-            size_t sizeBytes = sizeMB * 1024 * 1024;
-
-            std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
-            std::cout << "Testing with " << sizeMB << " MB file\n";
-            std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
+            threadCounts.push_back(config.maxThreads);
+        }
+        return threadCounts;
+    }
 
-            const size_t MAX_CHUNK_MB = 512;
-            size_t chunkSizeMB = std::min(sizeMB, MAX_CHUNK_MB);
-            size_t chunkSizeBytes = chunkSizeMB * 1024 * 1024;
-            size_t numChunks = (sizeMB + chunkSizeMB - 1) / chunkSizeMB;
+    // Authenticated algorithms next to AES-CTR of the same key size on the
+    // same engine: the throughput lost to GHASH and tags, and the tag bytes
+    // carried per file. Fixed-key AEADs are grouped by their key length.
+    void printAuthenticationOverhead(const ReportContext &ctx, size_t sizeBytes)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        auto best = [&](const std::string &algorithm, const std::string &engine)
+        {
+            auto it = ctx.bestThroughput.find(algorithm + "/" + engine);
+            return it == ctx.bestThroughput.end() ? 0.0 : it->second;
+        };
 
-            std::cout << "  Using " << numChunks << " chunk(s) of " << chunkSizeMB << " MB each\n";
-            std::cout << "  Generating random data (" << chunkSizeMB << " MB)... " << std::flush;
-            std::vector<uint8_t> data(chunkSizeBytes);
-            for (size_t i = 0; i < chunkSizeBytes; i += 8)
+        for (int bits : ctx.config.keySizes)
+        {
+            const std::string baseline = "AES-" + std::to_string(bits) + "-CTR";
+            std::vector<std::string> aead;
+            for (const auto &desc : registry.all())
             {
-                uint64_t val = gen();
-                std::memcpy(&data[i], &val, std::min<size_t>(8, chunkSizeBytes - i));
-            }
-            std::cout << "done\n\n";
-
-            std::map<std::string, double> baselineTimes;
-
-            std::cout << "  " << std::string(115, '-') << "\n";
-            std::cout << "  Algorithm    | Engine     | Thr | Throughput     | Time       | Speedup | Efficiency | Power  | Status\n";
-            std::cout << "  " << std::string(115, '-') << "\n";
-
-            XorSequentialEngine xorSeq;
-            AesSequentialEngine aesSeq;
-
-            xorSeq.initialize();
-            auto xorSeqResult = runChunkedBenchmark(&xorSeq, data, key, iv, config.verify, powerMonitor,
-                                                    config.iterations, 1, sizeMB, numChunks, 0);
-            baselineTimes["XOR"] = xorSeqResult.timeSec;
-            xorSeq.cleanup();
-            printResultLine(xorSeqResult, false);
-            logger.writeResult(xorSeqResult);
-            if (xorSeqResult.verified)
-                totalPassed++;
-            else
-                totalFailed++;
-
-            aesSeq.initialize();
-            auto aesSeqResult = runChunkedBenchmark(&aesSeq, data, key, iv, config.verify, powerMonitor,
-                                                    config.iterations, 1, sizeMB, numChunks, 0);
-            baselineTimes["AES-256-CTR"] = aesSeqResult.timeSec;
-            aesSeq.cleanup();
-            printResultLine(aesSeqResult, false);
-            logger.writeResult(aesSeqResult);
-            if (aesSeqResult.verified)
-                totalPassed++;
-            else
-                totalFailed++;
-
-#ifdef HAS_OPENMP
-            std::cout << "\n  [OpenMP Thread Scaling]\n";
-            std::cout << "  " << std::string(115, '-') << "\n";
-
-            for (int numThreads : threadCounts)
-            {
-                XorOpenMPEngine xorOmp;
-                xorOmp.setNumThreads(numThreads);
-                xorOmp.initialize();
-                auto result = runChunkedBenchmark(&xorOmp, data, key, iv, config.verify, powerMonitor,
-                                                  config.iterations, numThreads, sizeMB, numChunks, baselineTimes["XOR"]);
-                xorOmp.cleanup();
-                printResultLine(result, true);
-                logger.writeResult(result);
-                if (result.verified)
-                    totalPassed++;
-                else
-                    totalFailed++;
-            }
-
-            for (int numThreads : threadCounts)
-            {
-                AesOpenMPEngine aesOmp;
-                aesOmp.setNumThreads(numThreads);
-                aesOmp.initialize();
-                auto result = runChunkedBenchmark(&aesOmp, data, key, iv, config.verify, powerMonitor,
-                                                  config.iterations, numThreads, sizeMB, numChunks, baselineTimes["AES-256-CTR"]);
-                aesOmp.cleanup();
-                printResultLine(result, true);
-                logger.writeResult(result);
-                if (result.verified)
-                    totalPassed++;
-                else
-                    totalFailed++;
+                if (!desc.caps.authenticated || desc.caps.engine != "Sequential")
+                    continue;
+                int keyBits = desc.caps.keyBits;
+                if (keyBits == 0)
+                    keyBits = static_cast<int>(desc.create()->getKeyBytes() * 8);
+                if (keyBits == bits)
+                    aead.push_back(desc.caps.algorithm);
             }
-#endif
+            if (aead.empty())
+                continue;
 
-#ifdef HAS_METAL
-            std::cout << "\n  [Metal GPU]\n";
-            std::cout << "  " << std::string(115, '-') << "\n";
-
-            XorMetalEngine xorMetal;
-            if (xorMetal.isAvailable())
-            {
-                xorMetal.initialize();
-                auto result = runChunkedBenchmark(&xorMetal, data, key, iv, config.verify, powerMonitor,
-                                                  config.iterations, 1, sizeMB, numChunks, baselineTimes["XOR"]);
-                xorMetal.cleanup();
-                printResultLine(result, false);
-                logger.writeResult(result);
-                if (result.verified)
-                    totalPassed++;
-                else
-                    totalFailed++;
-            }
-
-            AesMetalEngine aesMetal;
-            if (aesMetal.isAvailable())
-            {
-                aesMetal.initialize();
-                auto result = runChunkedBenchmark(&aesMetal, data, key, iv, config.verify, powerMonitor,
-                                                  config.iterations, 1, sizeMB, numChunks, baselineTimes["AES-256-CTR"]);
-                aesMetal.cleanup();
-                printResultLine(result, false);
-                logger.writeResult(result);
-                if (result.verified)
-                    totalPassed++;
-                else
-                    totalFailed++;
+            std::cout << "\n  [Authentication Overhead vs " << baseline << "]\n";
+            std::cout << "  " << std::string(135, '-') << "\n";
+            for (const auto *desc : registry.forAlgorithm(baseline))
+            {
+                double ctr = best(baseline, desc->caps.engine);
+                if (ctr <= 0)
+                    continue;
+                std::cout << "    " << std::left << std::setw(11) << desc->caps.engine << std::right << "CTR "
+                          << std::fixed << std::setprecision(1) << ctr << " MB/s";
+                for (const auto &algorithm : aead)
+                {
+                    double mbs = best(algorithm, desc->caps.engine);
+                    if (mbs <= 0)
+                        continue;
+                    std::cout << " | " << algorithm << " " << mbs << " MB/s (" << std::showpos
+                              << (mbs / ctr - 1) * 100 << std::noshowpos << "%)";
+                }
+                std::cout << "\n";
             }
-#endif
 
-#ifdef HAS_CUDA
-            std::cout << "\n  [CUDA GPU]\n";
-            std::cout << "  " << std::string(115, '-') << "\n";
-
-            XorCudaEngine xorCuda;
-            if (xorCuda.isAvailable())
-            {
-                xorCuda.initialize();
-                auto result = runChunkedBenchmark(&xorCuda, data, key, iv, config.verify, powerMonitor,
-                                                  config.iterations, 1, sizeMB, numChunks, baselineTimes["XOR"]);
-                xorCuda.cleanup();
-                printResultLine(result, false);
-                logger.writeResult(result);
-                if (result.verified)
-                    totalPassed++;
-                else
-                    totalFailed++;
-            }
-
-            AesCudaEngine aesCuda;
-            if (aesCuda.isAvailable())
-            {
-                aesCuda.initialize();
-                auto result = runChunkedBenchmark(&aesCuda, data, key, iv, config.verify, powerMonitor,
-                                                  config.iterations, 1, sizeMB, numChunks, baselineTimes["AES-256-CTR"]);
-                aesCuda.cleanup();
-                printResultLine(result, false);
-                logger.writeResult(result);
-                if (result.verified)
-                    totalPassed++;
-                else
-                    totalFailed++;
+            std::cout << "    Tag bytes: ";
+            for (size_t i = 0; i < aead.size(); ++i)
+            {
+                size_t tagBytes = registry.create(aead[i], "Sequential")->getTagBytes(sizeBytes);
+                std::cout << (i ? ", " : "") << aead[i] << " " << tagBytes << " B (" << std::fixed
+                          << std::setprecision(3) << 100.0 * tagBytes / sizeBytes << "%)";
             }
-#endif
-
-            logger.flush();
             std::cout << "\n";
         }
+    }
 
-        std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
-        std::cout << "VERIFICATION SUMMARY\n";
-        std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
-        std::cout << "  Total Tests: " << (totalPassed + totalFailed) << "\n";
-        std::cout << "  Passed:      " << totalPassed << " (" << (100 * totalPassed / (totalPassed + totalFailed)) << "%)\n";
-        std::cout << "  Failed:      " << totalFailed << " (" << (100 * totalFailed / (totalPassed + totalFailed)) << "%)\n";
-
-        if (totalFailed == 0)
+    // Why `algorithm` cannot encrypt a message of `bytes` in one call, or
+    // nullptr if it can.
+    const char *unsupportedMessageSize(const std::string &algorithm, size_t bytes)
+    {
+        if (isCbcMode(algorithm) && bytes % 16 != 0)
+            return "CBC needs whole 16-byte blocks";
+        if (algorithm == "AES-256-XTS")
         {
-            std::cout << "\n  ✓ All encryption/decryption operations completed successfully!\n";
+            size_t tail = bytes % AesXtsEngine::defaultSectorBytes();
+            if (tail != 0 && tail < 16)
+                return "XTS needs at least 16 bytes after the last full sector";
+        }
+        return nullptr;
+    }
+
+    void runAutotune(const Config &config)
+    {
+#ifdef HAS_OPENMP
+        TuningCache &cache = TuningCache::shared();
+        std::vector<int> threadCounts = buildThreadCounts(config);
+        const OmpSchedule schedules[] = {OmpSchedule::Static, OmpSchedule::Dynamic, OmpSchedule::Guided};
+        const std::vector<size_t> chunkSizes = {16 * 1024, 64 * 1024, 256 * 1024,
+                                                1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024};
+
+        std::cout << "Autotuning OpenMP engines\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Candidates: " << chunkSizes.size() << " chunk sizes x 3 schedules x "
+                  << threadCounts.size() << " thread counts\n";
+        std::cout << "  Tuning file: " << cache.getPath() << "\n\n";
+
+        std::vector<uint8_t> key(MAX_KEY_BYTES);
+        std::vector<uint8_t> iv(16);
+        std::mt19937 gen(std::random_device{}());
+        for (auto &b : key)
+            b = static_cast<uint8_t>(gen());
+        for (auto &b : iv)
+            b = static_cast<uint8_t>(gen());
+
+        // Median encrypt time over config.iterations runs after warm-up, unverified.
+        auto timeEngine = [&](ICipherEngine &engine, const std::vector<uint8_t> &data, std::vector<uint8_t> &out)
+        {
+            for (int w = 0; w < config.warmupIterations; ++w)
+                engine.encrypt(data.data(), out.data(), data.size(), key.data(), engine.getKeyBytes(), iv.data());
+
+            std::vector<double> samples;
+            Timer timer;
+            for (int i = 0; i < std::max(config.iterations, 1); ++i)
+            {
+                timer.start();
+                engine.encrypt(data.data(), out.data(), data.size(), key.data(), engine.getKeyBytes(), iv.data());
+                timer.stop();
+                samples.push_back(timer.elapsedSeconds());
+            }
+            return percentile(samples, 50);
+        };
+
+        for (size_t sizeMB : config.fileSizesMB)
+        {
+            size_t sizeBytes = std::min<size_t>(sizeMB, 512) * 1024 * 1024;
+            std::vector<uint8_t> data(sizeBytes);
+            std::vector<uint8_t> out(sizeBytes);
+            for (auto &b : data)
+                b = static_cast<uint8_t>(gen());
+
+            std::cout << "  " << sizeMB << " MB (size class 2^" << sizeClassOf(sizeBytes) << ")\n";
+
+            // Sequential reference per size class lets the dispatcher place
+            // its crossover points from the tuning file alone.
+            for (const auto &algorithm : selectedAlgorithms(config))
+            {
+                if (unsupportedMessageSize(algorithm, sizeBytes))
+                    continue;
+                auto sequential = EngineRegistry::instance().create(algorithm, "Sequential");
+                TuningEntry entry;
+                entry.algorithm = algorithm;
+                entry.engine = sequential->getEngineName();
+                entry.sizeClass = sizeClassOf(sizeBytes);
+                entry.tuning = OmpTuning{1, OmpSchedule::Static, sizeBytes};
+                entry.throughputMBs = (sizeBytes / (1024.0 * 1024.0)) / timeEngine(*sequential, data, out);
+                cache.store(entry);
+                std::cout << "    " << std::left << std::setw(20) << algorithm << " sequential" << std::right
+                          << std::string(15, ' ') << std::fixed << std::setprecision(1) << std::setw(9)
+                          << entry.throughputMBs << " MB/s\n";
+            }
+
+            auto tune = [&](const EngineDescriptor &desc)
+            {
+                for (int numThreads : threadCounts)
+                {
+                    CipherEnginePtr reference = desc.create();
+                    reference->setNumThreads(numThreads);
+                    double defaultMBs = (sizeBytes / (1024.0 * 1024.0)) / timeEngine(*reference, data, out);
+
+                    TuningEntry best;
+                    best.algorithm = reference->getAlgorithmName();
+                    best.engine = reference->getEngineName();
+                    best.sizeClass = sizeClassOf(sizeBytes);
+
+                    for (OmpSchedule schedule : schedules)
+                    {
+                        for (size_t i = 0; i < chunkSizes.size(); ++i)
+                        {
+                            // Chunks beyond the payload all collapse to one work item.
+                            if (i > 0 && chunkSizes[i - 1] >= sizeBytes)
+                                break;
+
+                            OmpTuning candidate{numThreads, schedule, chunkSizes[i]};
+                            CipherEnginePtr engine = desc.create();
+                            engine->setNumThreads(numThreads);
+                            engine->setTuning(candidate);
+                            double mbs = (sizeBytes / (1024.0 * 1024.0)) / timeEngine(*engine, data, out);
+                            if (mbs > best.throughputMBs)
+                            {
+                                best.tuning = candidate;
+                                best.throughputMBs = mbs;
+                            }
+                        }
+                    }
+
+                    cache.store(best);
+                    std::cout << "    " << std::left << std::setw(20) << best.algorithm
+                              << " thr " << std::setw(3) << numThreads
+                              << " " << std::setw(8) << ompScheduleName(best.tuning.schedule)
+                              << std::right << std::setw(6) << best.tuning.chunkBytes / 1024 << " KB  "
+                              << std::fixed << std::setprecision(1) << std::setw(9) << best.throughputMBs
+                              << " MB/s (default " << defaultMBs << " MB/s)\n";
+                }
+            };
+
+            // Every registered OpenMP engine; one that ignores OmpTuning is
+            // listed as untunable instead of being skipped silently.
+            for (const auto &algorithm : selectedAlgorithms(config))
+            {
+                const EngineDescriptor *desc = EngineRegistry::instance().find(algorithm, "OpenMP");
+                if (!desc || unsupportedMessageSize(algorithm, sizeBytes))
+                    continue;
+                OmpTuning probe;
+                if (!desc->create()->getTuning(sizeBytes, probe))
+                {
+                    std::cout << "    " << std::left << std::setw(20) << algorithm << std::right
+                              << " untunable (fixed OpenMP schedule)\n";
+                    continue;
+                }
+                tune(*desc);
+            }
+            std::cout << "\n";
+        }
+
+        cache.save();
+        std::cout << "Tuning saved to: " << cache.getPath() << "\n\n";
+#else
+        (void)config;
+        throw std::runtime_error("--autotune requires a build with OpenMP");
+#endif
+    }
+
+    // "results.csv" + "_compare.json" -> "results_compare.json"
+    std::string siblingPath(const std::string &csvPath, const std::string &suffix)
+    {
+        std::string path = csvPath;
+        size_t dot = path.rfind(".csv");
+        if (dot != std::string::npos && dot + 4 == path.size())
+            path.erase(dot);
+        return path + suffix;
+    }
+
+    // 49152 -> "48 KB", 2097152 -> "2 MB"
+    std::string formatBytes(size_t bytes)
+    {
+        if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0)
+            return std::to_string(bytes / (1024 * 1024)) + " MB";
+        if (bytes >= 1024)
+            return std::to_string(bytes / 1024) + " KB";
+        return std::to_string(bytes) + " B";
+    }
+
+    void runLoadTest(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        LoadConfig load;
+        load.ratePerClient = config.loadRate;
+        load.durationSec = config.loadDurationSec;
+        load.engineThreads = config.loadEngineThreads;
+        load.payloads = parsePayloadMix(config.loadMix);
+
+        std::cout << "Concurrent Load Test\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Mode: " << (load.ratePerClient > 0 ? "open loop, " : "closed loop");
+        if (load.ratePerClient > 0)
+            std::cout << load.ratePerClient << " req/s per client";
+        std::cout << "\n  Payload mix: " << config.loadMix << "\n";
+        std::cout << "  Duration: " << load.durationSec << " s per run\n\n";
+
+        std::cout << "  " << std::string(131, '-') << "\n";
+        std::cout << "  Algorithm    | Engine     | Clients | Aggregate      | Req/s      | Fairness | p50 ms   | p95 ms   | p99 ms   | max ms   | Dropped\n";
+        std::cout << "  " << std::string(131, '-') << "\n";
+
+        std::vector<LoadResult> results;
+        for (const auto &algorithm : selectedAlgorithms(config))
+        {
+            const EngineDescriptor *desc = registry.find(algorithm, config.loadEngine);
+            if (!desc)
+            {
+                std::cout << "  (skipping " << algorithm << ": no " << config.loadEngine << " engine)\n";
+                continue;
+            }
+            const char *reason = nullptr;
+            size_t badSize = 0;
+            for (size_t size : load.payloads.sizes)
+            {
+                if ((reason = unsupportedMessageSize(algorithm, size)))
+                {
+                    badSize = size;
+                    break;
+                }
+            }
+            if (reason)
+            {
+                std::cout << "  (skipping " << algorithm << ": " << badSize << " B payload, " << reason << ")\n";
+                continue;
+            }
+
+            for (int clients : config.loadClients)
+            {
+                load.clients = clients;
+                LoadResult r = runLoad(desc->create, load);
+                std::cout << "  " << std::left << std::setw(12) << r.algorithm << " | " << std::setw(10) << r.engine
+                          << " | " << std::setw(7) << clients << " | " << std::right << std::fixed
+                          << std::setprecision(2) << std::setw(9) << r.aggregateMBs << " MB/s | "
+                          << std::setw(10) << std::setprecision(1) << r.requestsPerSec << " | "
+                          << std::setw(8) << std::setprecision(3) << r.fairness << " | "
+                          << std::setw(8) << r.latencyP50Sec * 1e3 << " | " << std::setw(8) << r.latencyP95Sec * 1e3
+                          << " | " << std::setw(8) << r.latencyP99Sec * 1e3 << " | " << std::setw(8) << r.latencyMaxSec * 1e3
+                          << " | " << std::setw(7) << r.dropped << std::left << "\n";
+                results.push_back(r);
+            }
+        }
+
+        std::string path = siblingPath(config.outputFile, "_load.csv");
+        writeLoadCsv(results, path);
+        std::cout << "\nLoad results saved to: " << path << "\n\n";
+    }
+
+    void runSoakTest(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        size_t bufferBytes = config.fileSizesMB.front() * 1024 * 1024;
+        double burstSec = std::min(config.burstSec, config.soakDurationSec / 2);
+
+        std::cout << "Sustained Load (Soak)\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Duration: " << config.soakDurationSec << " s per algorithm, sampled every "
+                  << config.sampleIntervalSec * 1000 << " ms\n";
+        std::cout << "  Buffer: " << config.fileSizesMB.front() << " MB per call, burst window: first "
+                  << burstSec << " s\n\n";
+
+        // An explicit --soak-algorithm overrides the --key-sizes filter.
+        std::vector<SoakResult> results;
+        for (const auto &algorithm : config.soakAlgorithm.empty() ? selectedAlgorithms(config) : registry.algorithms())
+        {
+            if (!config.soakAlgorithm.empty() && algorithm != config.soakAlgorithm)
+                continue;
+            const EngineDescriptor *desc = registry.find(algorithm, config.soakEngine);
+            if (!desc)
+            {
+                std::cout << "  (skipping " << algorithm << ": no " << config.soakEngine << " engine)\n";
+                continue;
+            }
+
+            auto engine = desc->create();
+            engine->initialize();
+            std::cout << "  " << algorithm << " / " << desc->caps.engine << "... " << std::flush;
+            SoakResult r = runSoak(*engine, bufferBytes, config.soakDurationSec, config.sampleIntervalSec, burstSec);
+            engine->cleanup();
+            std::cout << r.samples.size() << " samples\n";
+
+            auto printWindow = [](const char *label, const SoakWindow &w)
+            {
+                std::cout << "    " << std::left << std::setw(8) << label << std::right << std::fixed
+                          << std::setprecision(1) << std::setw(6) << w.seconds << " s  "
+                          << std::setprecision(2) << std::setw(10) << w.throughputMBs << " MB/s  "
+                          << std::setw(7) << w.watts << " W  "
+                          << std::setprecision(0) << std::setw(6) << w.freqAvgMHz << " MHz\n";
+            };
+            printWindow("Burst", r.burst);
+            printWindow("Steady", r.steady);
+            if (r.burst.throughputMBs > 0)
+            {
+                std::cout << "    Steady vs burst: " << std::showpos << std::fixed << std::setprecision(1)
+                          << (r.steady.throughputMBs / r.burst.throughputMBs - 1) * 100 << std::noshowpos
+                          << "% throughput\n";
+            }
+            results.push_back(r);
+        }
+
+        std::string path = siblingPath(config.outputFile, "_soak.csv");
+        writeSoakCsv(results, path);
+        std::cout << "\nTime series saved to: " << path << "\n\n";
+    }
+
+    void runEnergySearch(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        PowerMonitor powerMonitor;
+        std::vector<int> threadCounts = buildThreadCounts(config);
+        CpuTopology topology = CpuTopology::detect();
+        const std::vector<size_t> chunkSizes = {64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024};
+        const double minSeconds = 0.25;
+
+        std::cout << "Energy-Optimal Configuration Search\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Power source: " << (powerMonitor.isAvailable() ? powerMonitor.getSource() : "N/A (throughput/latency only)") << "\n";
+        std::cout << "  Sweep: " << threadCounts.size() << " thread counts x " << config.affinityPolicies.size()
+                  << " affinity policies x " << chunkSizes.size() << " chunk sizes per CPU engine"
+                  << " (chunk sizes only where the engine is tunable)\n\n";
+
+        std::vector<uint8_t> key(MAX_KEY_BYTES), iv(16);
+        std::mt19937 gen(std::random_device{}());
+        for (auto &b : key)
+            b = static_cast<uint8_t>(gen());
+        for (auto &b : iv)
+            b = static_cast<uint8_t>(gen());
+
+        // Repeats calls for at least minSeconds so RAPL has enough updates to
+        // resolve the energy of even small payloads.
+        auto measure = [&](ICipherEngine &engine, const std::vector<uint8_t> &data, std::vector<uint8_t> &out, EnergyPoint &point)
+        {
+            engine.encrypt(data.data(), out.data(), data.size(), key.data(), engine.getKeyBytes(), iv.data());
+
+            std::vector<double> samples;
+            Timer total, call;
+            powerMonitor.startMeasurement();
+            total.start();
+            do
+            {
+                call.start();
+                engine.encrypt(data.data(), out.data(), data.size(), key.data(), engine.getKeyBytes(), iv.data());
+                call.stop();
+                samples.push_back(call.elapsedSeconds());
+                total.stop();
+            } while (total.elapsedSeconds() < minSeconds || static_cast<int>(samples.size()) < config.iterations);
+            EnergyReading energy = powerMonitor.stopMeasurement();
+
+            double gigabytes = static_cast<double>(data.size()) * samples.size() / (1024.0 * 1024.0 * 1024.0);
+            point.latencySec = percentile(samples, 50);
+            point.throughputMBs = gigabytes * 1024.0 / total.elapsedSeconds();
+            point.energyValid = energy.valid && energy.joules > 0;
+            point.joules = energy.joules;
+            point.joulesPerGB = point.energyValid ? energy.joules / gigabytes : 0;
+            point.watts = energy.watts;
+        };
+
+        std::vector<std::vector<EnergyPoint>> groups;
+        for (size_t sizeMB : config.fileSizesMB)
+        {
+            const size_t measuredMB = std::min<size_t>(sizeMB, 512);
+            if (measuredMB != sizeMB)
+                std::cout << "  (" << sizeMB << " MB capped at " << measuredMB << " MB)\n";
+            size_t sizeBytes = measuredMB * 1024 * 1024;
+            std::vector<uint8_t> data(sizeBytes), out(sizeBytes);
+            for (auto &b : data)
+                b = static_cast<uint8_t>(gen());
+
+            for (const auto &algorithm : selectedAlgorithms(config))
+            {
+                std::vector<EnergyPoint> points;
+                EnergyPoint base;
+                base.sizeMB = measuredMB;
+                base.algorithm = algorithm;
+
+                for (const EngineDescriptor *desc : registry.forAlgorithm(algorithm))
+                {
+                    if (desc->caps.accelerator)
+                        continue;
+
+                    if (!desc->caps.threadControl)
+                    {
+                        auto engine = desc->create();
+                        engine->initialize();
+                        EnergyPoint point = base;
+                        point.engine = desc->caps.engine;
+                        measure(*engine, data, out, point);
+                        engine->cleanup();
+                        points.push_back(point);
+                        continue;
+                    }
+
+                    for (AffinityPolicy policy : config.affinityPolicies)
+                    {
+                        for (int numThreads : threadCounts)
+                        {
+                            std::vector<int> cpus = selectCpus(topology, policy, numThreads);
+                            if (policy != AffinityPolicy::None && (cpus.empty() || !pinThreads(cpus)))
+                                continue;
+
+                            for (size_t i = 0; i < chunkSizes.size(); ++i)
+                            {
+                                if (i > 0 && chunkSizes[i - 1] >= sizeBytes)
+                                    break;
+
+                                auto engine = desc->create();
+                                engine->setNumThreads(numThreads);
+                                engine->initialize();
+                                // Engines without tuning split work their own
+                                // way; they get one point with no chunk size.
+                                OmpTuning tuning;
+                                const bool tunable = engine->getTuning(sizeBytes, tuning);
+                                if (tunable)
+                                {
+                                    tuning.threads = numThreads;
+                                    tuning.chunkBytes = chunkSizes[i];
+                                    engine->setTuning(tuning);
+                                }
+
+                                EnergyPoint point = base;
+                                point.engine = desc->caps.engine;
+                                point.affinity = affinityPolicyName(policy);
+                                point.threads = numThreads;
+                                point.chunkBytes = tunable ? chunkSizes[i] : 0;
+                                measure(*engine, data, out, point);
+                                engine->cleanup();
+                                points.push_back(point);
+                                if (!tunable)
+                                    break;
+                            }
+                        }
+                        if (policy != AffinityPolicy::None)
+                            unpinThreads(topology);
+                    }
+                }
+
+                markParetoFrontier(points);
+                size_t energyBest = energyOptimal(points);
+                size_t latencyBest = latencyOptimal(points);
+
+                std::cout << "  " << algorithm << ", " << measuredMB << " MB: " << points.size() << " configurations, Pareto frontier:\n";
+                for (size_t i = 0; i < points.size(); ++i)
+                {
+                    const EnergyPoint &p = points[i];
+                    if (!p.pareto && i != energyBest && i != latencyBest)
+                        continue;
+                    std::cout << "    " << (p.pareto ? "* " : "  ") << std::left << std::setw(11) << p.engine
+                              << std::right << std::setw(3) << p.threads << " thr " << std::left << std::setw(9) << p.affinity
+                              << std::right << std::setw(6) << (p.chunkBytes ? std::to_string(p.chunkBytes / 1024) : "-") << " KB " << std::fixed
+                              << std::setprecision(2) << std::setw(10) << p.throughputMBs << " MB/s ";
+                    if (p.energyValid)
+                        std::cout << std::setw(8) << p.joulesPerGB << " J/GB " << std::setw(7) << p.watts << " W";
+                    else
+                        std::cout << "     N/A J/GB";
+                    if (i == energyBest)
+                        std::cout << "  <- energy-optimal";
+                    if (i == latencyBest)
+                        std::cout << "  <- latency-optimal";
+                    std::cout << "\n";
+                }
+                groups.push_back(points);
+            }
+            std::cout << "\n";
+        }
+
+        std::string path = siblingPath(config.outputFile, "_energy.csv");
+        writeEnergyCsv(groups, path);
+        std::cout << "Energy search saved to: " << path << "\n\n";
+    }
+
+    void runCacheSweep(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        std::vector<CacheLevel> caches = detectCacheLevels();
+        if (caches.empty())
+            throw std::runtime_error("Cache sizes not available on this platform");
+
+        const size_t maxWorkingSet = config.cacheSweepMaxMB * 1024 * 1024;
+        // Flushed mode rotates through twice the LLC so each call's buffers
+        // were evicted by the calls in between.
+        const size_t poolBytes = std::min(caches.back().sizeBytes * 2, maxWorkingSet);
+        const double minSeconds = 0.1;
+        std::vector<CacheSweepPoint> points = cacheSweepSizes(caches, 64, maxWorkingSet);
+
+        std::vector<std::string> levels;
+        for (const auto &c : caches)
+            levels.push_back(c.label);
+        levels.push_back("DRAM");
+
+        std::cout << "Cache-Hierarchy Working-Set Sweep\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Caches:";
+        for (const auto &c : caches)
+            std::cout << " " << c.label << " " << formatBytes(c.sizeBytes);
+        std::cout << "\n";
+        std::cout << "  " << points.size() << " sizes from " << formatBytes(points.front().bytes) << " to "
+                  << formatBytes(points.back().bytes) << " per call (working set = input + output), flushed pool "
+                  << formatBytes(poolBytes) << "\n\n";
+
+        std::vector<CacheSweepResult> results;
+        for (const auto &algorithm : selectedAlgorithms(config))
+        {
+            for (const EngineDescriptor *desc : registry.forAlgorithm(algorithm))
+            {
+                if (desc->caps.accelerator)
+                    continue;
+
+                auto engine = desc->create();
+                engine->initialize();
+                std::cout << "  " << algorithm << " / " << desc->caps.engine << "\n";
+                std::cout << "    " << std::left << std::setw(9) << "Mode" << std::right;
+                for (const auto &level : levels)
+                    std::cout << std::setw(12) << level;
+                std::cout << "   (MB/s, mean per level)\n";
+
+                for (CacheSweepMode mode : {CacheSweepMode::Warm, CacheSweepMode::Flushed})
+                {
+                    std::map<std::string, std::pair<double, int>> perLevel;
+                    for (const auto &point : points)
+                    {
+                        CacheSweepResult r = measureCacheSweep(*engine, point, mode, poolBytes, minSeconds);
+                        perLevel[point.level].first += r.throughputMBs;
+                        perLevel[point.level].second++;
+                        results.push_back(r);
+                    }
+
+                    std::cout << "    " << std::left << std::setw(9) << cacheSweepModeName(mode) << std::right;
+                    for (const auto &level : levels)
+                    {
+                        auto it = perLevel.find(level);
+                        if (it == perLevel.end())
+                            std::cout << std::setw(12) << "-";
+                        else
+                            std::cout << std::setw(12) << std::fixed << std::setprecision(1)
+                                      << it->second.first / it->second.second;
+                    }
+                    std::cout << "\n";
+                }
+                engine->cleanup();
+            }
+            std::cout << "\n";
+        }
+
+        std::string path = siblingPath(config.outputFile, "_cache.csv");
+        writeCacheSweepCsv(results, path);
+        std::cout << "Cache sweep saved to: " << path << "\n\n";
+    }
+
+    // Sector-granular requests as a block device issues them. AEADs are left
+    // out: reads decrypt whatever the device holds and would fail their tags.
+    void runSectorIoBenchmark(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        const size_t sectorBytes = AesXtsEngine::defaultSectorBytes();
+        const size_t requestSectors[] = {1, 8, 32};
+        const SectorPattern patterns[] = {SectorPattern::Random, SectorPattern::Sequential};
+        const SectorOp ops[] = {SectorOp::Write, SectorOp::Read};
+
+        std::cout << "Sector I/O Simulation\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Device: " << config.sectorIoDeviceMB << " MB, sector " << formatBytes(sectorBytes)
+                  << ", requests of 1/8/32 sectors, iv = first sector number\n\n";
+
+        std::vector<SectorIoResult> results;
+        for (const auto &algorithm : selectedAlgorithms(config))
+        {
+            for (const EngineDescriptor *desc : registry.forAlgorithm(algorithm))
+            {
+                if (desc->caps.accelerator || desc->caps.authenticated)
+                    continue;
+
+                auto engine = desc->create();
+                engine->initialize();
+                std::cout << "  " << algorithm << " / " << desc->caps.engine << "\n";
+                std::cout << "    Pattern    Op     Request        IOPS       MB/s    p50 us    p99 us\n";
+                for (SectorPattern pattern : patterns)
+                {
+                    for (SectorOp op : ops)
+                    {
+                        for (size_t sectors : requestSectors)
+                        {
+                            SectorIoConfig io;
+                            io.deviceBytes = config.sectorIoDeviceMB * 1024 * 1024;
+                            io.sectorBytes = sectorBytes;
+                            io.sectorsPerRequest = sectors;
+                            io.pattern = pattern;
+                            io.op = op;
+                            io.minSeconds = 0.1;
+                            SectorIoResult r = runSectorIo(*engine, io);
+                            std::cout << "    " << std::left << std::setw(11) << sectorPatternName(pattern)
+                                      << std::setw(7) << sectorOpName(op) << std::setw(8)
+                                      << formatBytes(sectorBytes * sectors) << std::right << std::fixed
+                                      << std::setprecision(0) << std::setw(12) << r.iops
+                                      << std::setprecision(1) << std::setw(11) << r.throughputMBs
+                                      << std::setprecision(2) << std::setw(10) << r.latencyP50Sec * 1e6
+                                      << std::setw(10) << r.latencyP99Sec * 1e6 << "\n";
+                            results.push_back(r);
+                        }
+                    }
+                }
+                engine->cleanup();
+                std::cout << "\n";
+            }
+        }
+
+        std::string path = siblingPath(config.outputFile, "_sector_io.csv");
+        writeSectorIoCsv(results, path);
+        std::cout << "Sector I/O results saved to: " << path << "\n\n";
+    }
+
+    void printKeyScheduleCacheStats()
+    {
+        KeyScheduleCache &cache = KeyScheduleCache::shared();
+        if (!cache.enabled())
+            return;
+        KeyScheduleStats stats = cache.getStats();
+        std::cout << "Key schedule cache: " << stats.entries << "/" << stats.capacity << " entries, " << stats.hits
+                  << " hits / " << stats.misses << " misses (" << std::fixed << std::setprecision(1)
+                  << stats.hitRate() * 100 << "% hit rate), " << stats.evictions << " evictions\n";
+        std::cout << "  Setup saved: " << std::setprecision(3) << stats.savedSeconds * 1e3 << " ms of key expansion"
+                  << " (misses spent " << stats.buildSeconds * 1e3 << " ms)\n\n";
+    }
+
+    BatchSubmit singleSubmit(ICipherEngine &engine)
+    {
+        return [&engine](const CipherJob *jobs, size_t count)
+        {
+            for (size_t j = 0; j < count; ++j)
+                engine.encrypt(jobs[j].input, jobs[j].output, jobs[j].size, jobs[j].key, jobs[j].keyLen, jobs[j].iv);
+        };
+    }
+
+    // Per-message cost of short independent messages on every CPU and GPU
+    // engine: one encrypt() per message against one encryptBatch() per
+    // --batch-jobs messages, each as a fraction of the Sequential engine's
+    // 1 MB single-call throughput. AEADs are left out: a job has no room
+    // for their tags.
+    void runSmallMessages(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        const size_t messageSizes[] = {64, 256, 1024, 4096};
+        const size_t bulkBytes = 1024 * 1024;
+        const double minSeconds = 0.2;
+
+        std::cout << "Small-Message Throughput\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Messages of 64 B - 4 KB, " << config.keyPool << (config.keyPool == 1 ? " key" : " keys")
+                  << ", distinct ivs; single calls vs batches of " << config.batchJobs
+                  << " jobs; % of the Sequential engine's " << formatBytes(bulkBytes) << " throughput\n\n";
+
+        std::vector<SmallMessageResult> results;
+        for (const auto &algorithm : selectedAlgorithms(config))
+        {
+            const EngineDescriptor *reference = registry.find(algorithm, "Sequential");
+            if (!reference || reference->caps.authenticated)
+                continue;
+
+            auto sequential = reference->create();
+            const size_t keyBytes = sequential->getKeyBytes();
+            SmallMessageResult bulk = measureSmallMessages(singleSubmit(*sequential), keyBytes, bulkBytes, 1, minSeconds);
+            bulk.algorithm = algorithm;
+            bulk.engine = sequential->getEngineName();
+            bulk.submission = "bulk";
+            bulk.bulkFraction = 1.0;
+            results.push_back(bulk);
+
+            std::cout << "  " << algorithm << " (bulk " << std::fixed << std::setprecision(1) << bulk.throughputMBs
+                      << " MB/s)\n";
+            std::cout << "    Engine      Submit    ";
+            for (size_t bytes : messageSizes)
+                std::cout << std::setw(17) << formatBytes(bytes);
+            std::cout << "   (MB/s, % of bulk)\n";
+
+            for (const EngineDescriptor *desc : registry.forAlgorithm(algorithm))
+            {
+                auto engine = desc->create();
+                if (!engine->isAvailable())
+                    continue;
+                engine->initialize();
+
+                ICipherEngine &e = *engine;
+                const BatchSubmit batch = [&e](const CipherJob *jobs, size_t count) { e.encryptBatch(jobs, count); };
+                for (bool batched : {false, true})
+                {
+                    const size_t jobsPerCall = batched ? config.batchJobs : 1;
+                    std::cout << "    " << std::left << std::setw(12) << desc->caps.engine
+                              << std::setw(10) << (batched ? "batch x" + std::to_string(jobsPerCall) : "single")
+                              << std::right;
+                    for (size_t bytes : messageSizes)
+                    {
+                        SmallMessageResult r = measureSmallMessages(batched ? batch : singleSubmit(e), keyBytes, bytes,
+                                                                    jobsPerCall, minSeconds, config.keyPool);
+                        r.algorithm = algorithm;
+                        r.engine = engine->getEngineName();
+                        r.submission = batched ? "batch" : "single";
+                        r.bulkFraction = r.throughputMBs / bulk.throughputMBs;
+                        results.push_back(r);
+                        std::cout << std::fixed << std::setprecision(1) << std::setw(11) << r.throughputMBs
+                                  << std::setprecision(0) << std::setw(5) << r.bulkFraction * 100 << "%";
+                    }
+                    std::cout << "\n";
+                }
+                engine->cleanup();
+            }
+            std::cout << "\n";
+        }
+
+        std::string path = siblingPath(config.outputFile, "_small_messages.csv");
+        writeSmallMessagesCsv(results, path);
+        std::cout << "Small-message results saved to: " << path << "\n\n";
+    }
+
+    // One stream of the largest --sizes, encrypted in 1 MB calls under a new
+    // key every --key-rotation bytes, on every CPU engine of the seekable
+    // algorithms: switching keys with the schedule built in the timed call
+    // (inline) and with the next call's keys built in the background
+    // (prefetch), each against the same engine with a single key. All three
+    // runs use the same key schedule cache size, so the percentages show
+    // the re-keying and not the cache.
+    void runKeyRotation(const Config &config)
+    {
+        EngineRegistry &registry = EngineRegistry::instance();
+        const uint64_t streamBytes =
+            static_cast<uint64_t>(*std::max_element(config.fileSizesMB.begin(), config.fileSizesMB.end())) * 1024 * 1024;
+        const size_t callBytes = std::min<uint64_t>(1024 * 1024, streamBytes);
+        const uint64_t interval = config.keyRotationBytes;
+        // Room for the keys of the current and the next call; anything older
+        // is evicted, so a range's key is only ever warm because of prefetch.
+        const size_t cacheEntries = 4 * (callBytes / interval + 2);
+
+        std::cout << "Key Rotation\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  Stream " << formatBytes(streamBytes) << " in " << formatBytes(callBytes)
+                  << " calls, new key every " << formatBytes(interval) << "; % of the single-key run on the same engine\n";
+        if (std::thread::hardware_concurrency() < 2)
+            std::cout << "  (1 CPU: the prefetch thread takes its time from encryption)\n";
+        std::cout << "\n";
+
+        std::mt19937 gen(0x4073);
+        std::vector<uint8_t> chunk(callBytes), iv(16);
+        for (auto &b : chunk)
+            b = static_cast<uint8_t>(gen());
+        for (auto &b : iv)
+            b = static_cast<uint8_t>(gen());
+        // Checked on a short stream with several switches inside each call,
+        // whatever the interval under test.
+        std::vector<uint8_t> verifyData(1024 * 1024);
+        for (auto &b : verifyData)
+            b = static_cast<uint8_t>(gen());
+
+        std::vector<KeyRotationResult> results;
+        for (const auto &algorithm : selectedAlgorithms(config))
+        {
+            const EngineDescriptor *reference = registry.find(algorithm, "Sequential");
+            if (!reference || reference->caps.authenticated || !isSeekable(algorithm))
+                continue;
+            if (interval % streamAlignment(algorithm) != 0)
+            {
+                std::cout << "  (skipping " << algorithm << ": interval not a multiple of "
+                          << streamAlignment(algorithm) << " bytes)\n\n";
+                continue;
+            }
+
+            auto referenceEngine = reference->create();
+            const size_t keyBytes = referenceEngine->getKeyBytes();
+            KeyRotation rotation(keyBytes, interval, streamBytes);
+            KeyRotation singleKey(keyBytes, streamBytes, streamBytes);
+            KeyRotation verifyRotation(keyBytes, 256 * 1024, verifyData.size());
+
+            std::cout << "  " << algorithm << "\n";
+            std::cout << "    Engine      Thr  Switches    single-key          inline        prefetch   Verify\n";
+            for (const EngineDescriptor *desc : registry.forAlgorithm(algorithm))
+            {
+                if (desc->caps.accelerator)
+                    continue;
+                auto engine = desc->create();
+                if (!engine->isAvailable())
+                    continue;
+                const int threads = desc->caps.threadControl ? config.maxThreads : 1;
+                if (desc->caps.threadControl)
+                    engine->setNumThreads(threads);
+                engine->initialize();
+
+                bool verified = verifyKeyRotation(*engine, *referenceEngine, verifyRotation, verifyData, iv.data(),
+                                                  384 * 1024);
+                KeyRotationResult base = measureKeyRotation(*engine, singleKey, RekeyMode::Inline, chunk, iv.data(),
+                                                            streamBytes, config.iterations, cacheEntries);
+                base.variant = "single-key";
+                KeyRotationResult inlined = measureKeyRotation(*engine, rotation, RekeyMode::Inline, chunk, iv.data(),
+                                                               streamBytes, config.iterations, cacheEntries);
+                inlined.variant = rekeyModeName(RekeyMode::Inline);
+                KeyRotationResult prefetched = measureKeyRotation(*engine, rotation, RekeyMode::Prefetch, chunk,
+                                                                  iv.data(), streamBytes, config.iterations,
+                                                                  cacheEntries);
+                prefetched.variant = rekeyModeName(RekeyMode::Prefetch);
+                engine->cleanup();
+
+                std::cout << "    " << std::left << std::setw(12) << desc->caps.engine << std::right << std::setw(3)
+                          << threads << std::setw(10) << inlined.keySwitches << std::fixed << std::setprecision(1)
+                          << std::setw(14) << base.throughputMBs;
+                for (KeyRotationResult *r : {&base, &inlined, &prefetched})
+                {
+                    r->algorithm = algorithm;
+                    r->engine = desc->caps.engine;
+                    r->threads = threads;
+                    r->baselineFraction = r->throughputMBs / base.throughputMBs;
+                    r->verified = verified;
+                    results.push_back(*r);
+                }
+                for (const KeyRotationResult *r : {&inlined, &prefetched})
+                {
+                    std::cout << std::setprecision(1) << std::setw(11) << r->throughputMBs
+                              << std::setprecision(0) << std::setw(5) << r->baselineFraction * 100 << "%";
+                }
+                std::cout << "   " << (verified ? "PASS" : "FAIL") << "\n";
+            }
+            std::cout << "\n";
+        }
+
+        std::string path = siblingPath(config.outputFile, "_key_rotation.csv");
+        writeKeyRotationCsv(results, path);
+        std::cout << "Key rotation results saved to: " << path << "\n\n";
+    }
+
+    template <template <int> class Engine>
+    CipherEnginePtr makeAesCtrEngine(int keyBits, const EvpUsage &usage)
+    {
+        switch (keyBits)
+        {
+        case 128:
+            return CipherEnginePtr(new Engine<128>(usage));
+        case 192:
+            return CipherEnginePtr(new Engine<192>(usage));
+        default:
+            return CipherEnginePtr(new Engine<256>(usage));
+        }
+    }
+
+    // AES-CTR under every OpenSSL usage pattern (cipher fetch x context
+    // lifetime): one Sequential encrypt() per 64 B / 1 KB / 16 KB message,
+    // where per-call setup dominates, then OpenMP over the thread sweep on
+    // 4 MB calls of 64 KB chunks, where every chunk re-inits a context.
+    // Setup time per init growing with the thread count is lock contention.
+    void runEvpStudy(const Config &config)
+    {
+        std::vector<EvpUsage> variants;
+        for (EvpFetch fetch : {EvpFetch::Implicit, EvpFetch::Process, EvpFetch::LibCtx})
+        {
+            if (!evpFetchAvailable(fetch))
+                continue;
+            for (EvpContext context : {EvpContext::Fresh, EvpContext::Reset})
+                variants.push_back(EvpUsage{fetch, context});
+        }
+
+        const size_t messageSizes[] = {64, 1024, 16 * 1024};
+        const size_t parallelBytes = 4 * 1024 * 1024;
+        const size_t parallelChunk = 64 * 1024;
+        const double minSeconds = 0.1;
+
+        std::cout << "OpenSSL EVP Usage Study\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  " << OpenSSL_version(OPENSSL_VERSION) << "\n";
+        std::cout << "  fetch: implicit = EVP_aes_*_ctr() per init, process = EVP_CIPHER_fetch once,"
+                  << " libctx = fetched once in an own OSSL_LIB_CTX\n";
+        std::cout << "  context: fresh = new per call (and thread), reset = reused after EVP_CIPHER_CTX_reset\n";
+        std::cout << "  setup = context new/reset + EVP_EncryptInit_ex, mean per init and thread\n\n";
+
+        KeyScheduleCache &cache = KeyScheduleCache::shared();
+        const size_t savedCapacity = cache.getCapacity();
+        cache.setCapacity(0); // cached contexts would bypass the fetch under test
+        setEvpSetupTiming(true);
+
+        std::vector<EvpStudyResult> results;
+        for (int keyBits : config.keySizes)
+        {
+            const std::string algorithm = "AES-" + std::to_string(keyBits) + "-CTR";
+            const size_t keyBytes = static_cast<size_t>(keyBits / 8);
+
+            std::cout << "  " << algorithm << " Sequential: one encrypt() per message\n";
+            std::cout << "    Variant          ";
+            for (size_t bytes : messageSizes)
+                std::cout << std::setw(12) << formatBytes(bytes);
+            std::cout << "   setup ns/init\n";
+            for (const EvpUsage &usage : variants)
+            {
+                auto engine = makeAesCtrEngine<AesSequentialEngine>(keyBits, usage);
+                std::cout << "    " << std::left << std::setw(17) << evpUsageName(usage) << std::right;
+                EvpSetupStats setupTotal;
+                for (size_t bytes : messageSizes)
+                {
+                    takeEvpSetupStats();
+                    SmallMessageResult m = measureSmallMessages(singleSubmit(*engine), keyBytes, bytes, 1, minSeconds);
+                    EvpSetupStats setup = takeEvpSetupStats();
+                    setupTotal.inits += setup.inits;
+                    setupTotal.seconds += setup.seconds;
+
+                    EvpStudyResult r;
+                    r.algorithm = algorithm;
+                    r.engine = engine->getEngineName();
+                    r.fetch = evpFetchName(usage.fetch);
+                    r.context = evpContextName(usage.context);
+                    r.callBytes = bytes;
+                    r.throughputMBs = m.throughputMBs;
+                    r.nsPerCall = m.nsPerMessage;
+                    r.setupInits = setup.inits;
+                    r.setupNsPerInit = setup.nsPerInit();
+                    results.push_back(r);
+                    std::cout << std::fixed << std::setprecision(0) << std::setw(9) << m.nsPerMessage << " ns";
+                }
+                std::cout << std::setw(16) << setupTotal.nsPerInit() << "\n";
+            }
+            std::cout << "\n";
+
+#ifdef HAS_OPENMP
+            std::cout << "  " << algorithm << " OpenMP: " << formatBytes(parallelBytes) << " calls in "
+                      << formatBytes(parallelChunk) << " chunks\n";
+            std::cout << "    Variant           Thr        MB/s   setup ns/init   vs 1 thr\n";
+            for (const EvpUsage &usage : variants)
+            {
+                auto engine = makeAesCtrEngine<AesOpenMPEngine>(keyBits, usage);
+                double oneThreadSetup = 0;
+                for (int threads : buildThreadCounts(config))
+                {
+                    engine->setTuning(OmpTuning{threads, OmpSchedule::Dynamic, parallelChunk});
+                    takeEvpSetupStats();
+                    SmallMessageResult m = measureSmallMessages(singleSubmit(*engine), keyBytes, parallelBytes, 1,
+                                                                minSeconds);
+                    EvpSetupStats setup = takeEvpSetupStats();
+
+                    EvpStudyResult r;
+                    r.algorithm = algorithm;
+                    r.engine = engine->getEngineName();
+                    r.fetch = evpFetchName(usage.fetch);
+                    r.context = evpContextName(usage.context);
+                    r.threads = threads;
+                    r.callBytes = parallelBytes;
+                    r.throughputMBs = m.throughputMBs;
+                    r.nsPerCall = m.nsPerMessage;
+                    r.setupInits = setup.inits;
+                    r.setupNsPerInit = setup.nsPerInit();
+                    if (threads == 1)
+                        oneThreadSetup = r.setupNsPerInit;
+                    if (oneThreadSetup > 0)
+                        r.setupVsOneThread = r.setupNsPerInit / oneThreadSetup;
+                    results.push_back(r);
+
+                    std::cout << "    " << std::left << std::setw(17) << evpUsageName(usage) << std::right
+                              << std::setw(4) << threads << std::fixed << std::setprecision(1) << std::setw(12)
+                              << r.throughputMBs << std::setprecision(0) << std::setw(16) << r.setupNsPerInit;
+                    if (r.setupVsOneThread > 0)
+                        std::cout << std::setprecision(2) << std::setw(10) << r.setupVsOneThread << "x";
+                    std::cout << "\n";
+                }
+            }
+            std::cout << "\n";
+#endif
+        }
+
+        setEvpSetupTiming(false);
+        cache.setCapacity(savedCapacity);
+
+        std::string path = siblingPath(config.outputFile, "_evp_study.csv");
+        writeEvpStudyCsv(results, path);
+        std::cout << "EVP usage results saved to: " << path << "\n\n";
+    }
+
+    void runBenchmarks(const Config &config)
+    {
+        PowerMonitor powerMonitor;
+        PerfCounters perf;
+        PerfCounters *perfCounters = (config.perfCounters && perf.isAvailable()) ? &perf : nullptr;
+
+        std::cout << "Test Configuration:\n";
+        std::cout << "───────────────────\n";
+        std::cout << "  File sizes: ";
+        for (size_t i = 0; i < config.fileSizesMB.size(); ++i)
+        {
+            std::cout << config.fileSizesMB[i] << " MB";
+            if (i < config.fileSizesMB.size() - 1)
+                std::cout << ", ";
+        }
+        std::cout << "\n";
+        std::cout << "  Iterations: " << config.iterations << " (+" << config.warmupIterations << " warm-up)";
+        if (config.targetCIPercent > 0)
+            std::cout << ", adaptive until CI95 <= " << config.targetCIPercent << "% (max " << config.maxIterations << ")";
+        std::cout << "\n";
+        std::cout << "  AES Key Sizes: ";
+        for (size_t i = 0; i < config.keySizes.size(); ++i)
+            std::cout << (i ? ", " : "") << config.keySizes[i];
+        std::cout << " bits\n";
+        std::cout << "  Verification: ";
+        if (!config.verify)
+            std::cout << "disabled\n";
+        else if (config.verifySamples > 0)
+            std::cout << "sampled (" << config.verifySamples << " x 4 KB windows)\n";
+        else
+            std::cout << "full\n";
+        std::cout << "  Thread Scaling: " << (config.threadScaling ? "enabled" : "disabled") << "\n";
+        std::cout << "  Max Threads: " << config.maxThreads << "\n";
+        std::cout << "  Power Monitoring: " << (powerMonitor.isAvailable() ? powerMonitor.getSource() : "N/A");
+        std::vector<std::string> domains = powerMonitor.getDomainNames();
+        for (size_t i = 0; i < domains.size(); ++i)
+            std::cout << (i ? ", " : " (") << domains[i] << (i + 1 == domains.size() ? ")" : "");
+        std::cout << "\n";
+        std::cout << "  Perf Counters: " << (config.perfCounters ? perf.getStatus() : "disabled") << "\n";
+        const TuningCache &tuningCache = TuningCache::shared();
+        std::cout << "  Tuning Cache: " << tuningCache.getPath() << " ("
+                  << tuningCache.getEntries().size() << " entries)\n";
+        std::cout << "  Output: " << config.outputFile << "\n\n";
+
+        CsvLogger logger(config.outputFile);
+        logger.writeHeader();
+
+        std::vector<uint8_t> key(MAX_KEY_BYTES);
+        std::vector<uint8_t> iv(16);
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::uniform_int_distribution<> dis(0, 255);
+        for (auto &b : key)
+            b = static_cast<uint8_t>(dis(gen));
+        for (auto &b : iv)
+            b = static_cast<uint8_t>(dis(gen));
+
+        std::vector<int> threadCounts = buildThreadCounts(config);
+        CpuTopology topology = CpuTopology::detect();
+
+        std::cout << "  CPU Topology: " << topology.packageCount() << " package(s), "
+                  << topology.physicalCoreCount() << " core(s), SMT x" << topology.smtWidth() << "\n";
+        std::cout << "  Thread counts:";
+        for (int t : threadCounts)
+            std::cout << " " << t;
+        std::cout << "\n  Affinity:";
+        for (AffinityPolicy policy : config.affinityPolicies)
+            std::cout << " " << affinityPolicyName(policy);
+        std::cout << "\n\n";
+
+        BandwidthProfile bandwidth;
+        if (config.bandwidthProbe)
+        {
+            std::cout << "  Probing memory bandwidth (" << config.probeMB << " MB arrays)... " << std::flush;
+            bandwidth = measureBandwidth(threadCounts, config.probeMB * 1024 * 1024);
+            std::cout << "done\n\n";
+            printBandwidthProfile(bandwidth);
+        }
+
+        ReportContext report{config, logger, config.bandwidthProbe ? &bandwidth : nullptr, 0, 0, {}};
+
+        std::vector<std::unique_ptr<DispatchEngine>> dispatchers;
+        if (config.dispatch)
+        {
+            for (const auto &algorithm : selectedAlgorithms(config))
+            {
+                std::unique_ptr<DispatchEngine> dispatcher(new DispatchEngine(algorithm));
+                dispatcher->initialize();
+                if (!dispatcher->isCalibrated())
+                {
+                    std::cout << "  Calibrating " << algorithm << " dispatcher... " << std::flush;
+                    dispatcher->calibrate({4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024});
+                    std::cout << "done\n";
+                }
+                std::cout << "  " << algorithm << " routes:";
+                for (size_t size = 4 * 1024; size <= 256 * 1024 * 1024; size *= 16)
+                {
+                    std::cout << " " << (size >= 1024 * 1024 ? size / (1024 * 1024) : size / 1024)
+                              << (size >= 1024 * 1024 ? " MB" : " KB") << "->" << dispatcher->select(size).getEngineName();
+                }
+                std::cout << "\n";
+                dispatchers.push_back(std::move(dispatcher));
+            }
+            std::cout << "\n";
+        }
+
+        for (size_t sizeMB : config.fileSizesMB)
+        {
+            size_t sizeBytes = sizeMB * 1024 * 1024;
+
+            std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
+            std::cout << "Testing with " << sizeMB << " MB file\n";
+            std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
+
+            const size_t MAX_CHUNK_MB = 512;
+            size_t chunkSizeMB = std::min(sizeMB, MAX_CHUNK_MB);
+            size_t chunkSizeBytes = chunkSizeMB * 1024 * 1024;
+            size_t numChunks = (sizeMB + chunkSizeMB - 1) / chunkSizeMB;
+
+            std::cout << "  Using " << numChunks << " chunk(s) of " << chunkSizeMB << " MB each\n";
+            std::cout << "  Generating random data (" << chunkSizeMB << " MB)... " << std::flush;
+            std::vector<uint8_t> data(chunkSizeBytes);
+            for (size_t i = 0; i < chunkSizeBytes; i += 8)
+            {
+                uint64_t val = gen();
+                std::memcpy(&data[i], &val, std::min<size_t>(8, chunkSizeBytes - i));
+            }
+            std::cout << "done\n\n";
+
+            std::map<std::string, double> baselineTimes;
+            std::map<std::string, double> baselineDecryptTimes;
+
+            std::cout << "  " << std::string(135, '-') << "\n";
+            std::cout << "  Algorithm    | Engine     | Thr | Throughput     | Median     | Speedup | Efficiency | BW%     | Power    | CI95    | Status\n";
+            std::cout << "  " << std::string(135, '-') << "\n";
+
+            EngineRegistry &registry = EngineRegistry::instance();
+
+            for (const auto &desc : registry.all())
+            {
+                if (desc.caps.engine != "Sequential" || !keySizeSelected(config, desc.caps))
+                    continue;
+                auto engine = desc.create();
+                engine->initialize();
+                auto result = runChunkedBenchmark(engine.get(), data, key, iv, config,
+                                                  powerMonitor, perfCounters, 1, sizeMB, numChunks, 0);
+                baselineTimes[desc.caps.algorithm] = result.timeMedianSec;
+                baselineDecryptTimes[desc.caps.algorithm] = result.decryptTimeMedianSec;
+                engine->cleanup();
+                reportResult(result, false, report);
+            }
+
+            auto runScaling = [&](const EngineDescriptor &desc, double baselineTime, double baselineDecryptTime)
+            {
+                for (AffinityPolicy policy : config.affinityPolicies)
+                {
+                    for (int numThreads : threadCounts)
+                    {
+                        std::vector<int> cpus = selectCpus(topology, policy, numThreads);
+                        if (policy != AffinityPolicy::None)
+                        {
+                            if (cpus.empty())
+                            {
+                                std::cout << "  (skipping " << numThreads << " threads: not placeable with "
+                                          << affinityPolicyName(policy) << " policy)\n";
+                                continue;
+                            }
+                            if (!pinThreads(cpus))
+                                std::cout << "  (warning: could not pin threads to CPUs " << formatCpuList(cpus) << ")\n";
+                        }
+
+                        auto engine = desc.create();
+                        engine->setNumThreads(numThreads);
+                        engine->initialize();
+                        auto result = runChunkedBenchmark(engine.get(), data, key, iv, config,
+                                                          powerMonitor, perfCounters, numThreads, sizeMB, numChunks, baselineTime,
+                                                          baselineDecryptTime);
+                        engine->cleanup();
+                        result.affinity = affinityPolicyName(policy);
+                        result.cpuList = formatCpuList(cpus);
+                        OmpTuning tuning;
+                        if (engine->getTuning(data.size(), tuning))
+                        {
+                            result.schedule = ompScheduleName(tuning.schedule);
+                            result.chunkBytes = tuning.chunkBytes;
+                        }
+                        reportResult(result, true, report);
+                    }
+
+                    if (policy != AffinityPolicy::None)
+                        unpinThreads(topology);
+                }
+            };
+
+            std::string section;
+            for (const auto &desc : registry.all())
+            {
+                if (desc.caps.engine == "Sequential" || !keySizeSelected(config, desc.caps))
+                    continue;
+                if (desc.caps.engine != section)
+                {
+                    section = desc.caps.engine;
+                    std::cout << "\n  [" << section
+                              << (desc.caps.threadControl ? " Thread Scaling]\n" : desc.caps.accelerator ? " GPU]\n" : "]\n");
+                    std::cout << "  " << std::string(135, '-') << "\n";
+                }
+
+                if (desc.caps.threadControl)
+                {
+                    runScaling(desc, baselineTimes[desc.caps.algorithm], baselineDecryptTimes[desc.caps.algorithm]);
+                    continue;
+                }
+
+                auto engine = desc.create();
+                if (engine->isAvailable())
+                {
+                    engine->initialize();
+                    auto result = runChunkedBenchmark(engine.get(), data, key, iv, config,
+                                                      powerMonitor, perfCounters, 1, sizeMB, numChunks, baselineTimes[desc.caps.algorithm],
+                                                      baselineDecryptTimes[desc.caps.algorithm]);
+                    engine->cleanup();
+                    reportResult(result, false, report);
+                }
+            }
+
+            if (!dispatchers.empty())
+            {
+                std::cout << "\n  [Dispatcher]\n";
+                std::cout << "  " << std::string(135, '-') << "\n";
+                for (auto &dispatcher : dispatchers)
+                {
+                    auto result = runChunkedBenchmark(dispatcher.get(), data, key, iv, config,
+                                                      powerMonitor, perfCounters, 1, sizeMB, numChunks,
+                                                      baselineTimes[dispatcher->getAlgorithmName()]);
+                    reportResult(result, false, report);
+                    std::cout << "    -> routed to " << dispatcher->getLastEngine() << "\n";
+                }
+            }
+
+            if (!config.splitMembers.empty())
+            {
+                std::cout << "\n  [Split Execution]\n";
+                std::cout << "  " << std::string(135, '-') << "\n";
+                for (const auto &algorithm : selectedAlgorithms(config))
+                {
+                    if (!isSeekable(algorithm))
+                    {
+                        std::cout << "  (skipping " << algorithm << ": stream positions cannot be seeked)\n";
+                        continue;
+                    }
+                    std::vector<CipherEnginePtr> members;
+                    for (const auto &name : config.splitMembers)
+                    {
+                        if (registry.find(algorithm, name))
+                            members.push_back(registry.create(algorithm, name));
+                    }
+                    if (members.size() != config.splitMembers.size())
+                    {
+                        std::cout << "  (skipping " << algorithm << ": not every split member is available)\n";
+                        continue;
+                    }
+
+                    SplitEngine split(algorithm, std::move(members));
+                    split.initialize();
+                    auto result = runChunkedBenchmark(&split, data, key, iv, config,
+                                                      powerMonitor, perfCounters, 1, sizeMB, numChunks, baselineTimes[algorithm]);
+
+                    // Slices are encrypted from seeked stream positions, so the
+                    // whole buffer must match the single-engine reference.
+                    std::vector<uint8_t> splitOut(data.size());
+                    std::vector<uint8_t> referenceOut(data.size());
+                    split.encrypt(data.data(), splitOut.data(), data.size(), key.data(), split.getKeyBytes(), iv.data());
+                    makeReferenceEngine(algorithm)->encrypt(data.data(), referenceOut.data(), data.size(),
+                                                            key.data(), split.getKeyBytes(), iv.data());
+                    bool identical = splitOut == referenceOut;
+                    split.cleanup();
+
+                    result.verified = result.verified && identical;
+                    reportResult(result, false, report);
+                    std::cout << "    -> " << split.describeSplit()
+                              << (identical ? ", byte-identical to Sequential\n" : ", MISMATCH vs Sequential\n");
+                }
+            }
+
+            printAuthenticationOverhead(report, sizeBytes);
+            report.bestThroughput.clear();
+
+            logger.flush();
+            std::cout << "\n";
+        }
+
+        std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
+        std::cout << "VERIFICATION SUMMARY\n";
+        std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
+        int totalPassed = report.passed;
+        int totalFailed = report.failed;
+        std::cout << "  Total Tests: " << (totalPassed + totalFailed) << "\n";
+        std::cout << "  Passed:      " << totalPassed << " (" << (100 * totalPassed / (totalPassed + totalFailed)) << "%)\n";
+        std::cout << "  Failed:      " << totalFailed << " (" << (100 * totalFailed / (totalPassed + totalFailed)) << "%)\n";
+
+        if (totalFailed == 0)
+        {
+            std::cout << "\n  ✓ All encryption/decryption operations completed successfully!\n";
         }
         else
         {
@@ -572,6 +2272,43 @@ namespace hpc_benchmark
         std::cout << "Generate charts with: python3 scripts/generate_charts.py " << config.outputFile << "\n\n";
     }
 
+    int runComparison(const Config &config)
+    {
+        std::string reportPath = config.compareReport.empty() ? siblingPath(config.outputFile, "_compare.json")
+                                                              : config.compareReport;
+
+        ComparisonReport report = compareResultFiles(config.compareFile, config.outputFile,
+                                                     config.regressionThresholdPercent);
+        writeComparisonJson(report, reportPath);
+
+        std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
+        std::cout << "REGRESSION CHECK vs " << config.compareFile << "\n";
+        std::cout << "═══════════════════════════════════════════════════════════════════════════\n";
+        std::cout << "  Matched rows: " << report.rows.size() << " (unmatched: " << report.unmatchedBaseline
+                  << " baseline, " << report.unmatchedCurrent << " current)\n";
+        std::cout << "  Threshold:    " << config.regressionThresholdPercent << "%\n";
+
+        for (const auto &row : report.rows)
+        {
+            if (row.throughput.status == ComparisonStatus::Unchanged && row.energy.status == ComparisonStatus::Unchanged)
+                continue;
+            std::cout << "  " << (row.regressed() ? "✗ " : "✓ ") << std::left << std::setw(12) << row.algorithm
+                      << std::setw(11) << row.engine << std::right << std::setw(5) << row.fileSizeMB << " MB "
+                      << std::setw(3) << row.numThreads << " thr";
+            if (row.throughput.status != ComparisonStatus::Unchanged)
+                std::cout << "  throughput " << std::showpos << std::fixed << std::setprecision(1)
+                          << row.throughput.changePercent << std::noshowpos << "%";
+            if (row.energy.status != ComparisonStatus::Unchanged)
+                std::cout << "  energy " << std::showpos << std::fixed << std::setprecision(1)
+                          << row.energy.changePercent << std::noshowpos << "%";
+            std::cout << "\n";
+        }
+
+        std::cout << "  Regressions:  " << report.regressions() << ", improvements: " << report.improvements() << "\n";
+        std::cout << "  Report:       " << reportPath << "\n\n";
+        return report.regressions() > 0 ? 2 : 0;
+    }
+
 }
 
 int main(int argc, char *argv[])
@@ -579,9 +2316,18 @@ int main(int argc, char *argv[])
     using namespace hpc_benchmark;
 
     Config config;
-    if (!parseArgs(argc, argv, config))
+    try
     {
-        return 0;
+        if (!parseArgs(argc, argv, config))
+        {
+            return 0;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        printUsage(argv[0]);
+        return 1;
     }
 
     printHeader();
@@ -589,7 +2335,57 @@ int main(int argc, char *argv[])
 
     try
     {
-        runBenchmarks(config);
+        if (!config.tuningFile.empty())
+        {
+            TuningCache::shared().setPath(config.tuningFile);
+            TuningCache::shared().load();
+        }
+
+        if (config.autotune)
+        {
+            runAutotune(config);
+        }
+        else if (!config.loadClients.empty())
+        {
+            runLoadTest(config);
+            printKeyScheduleCacheStats();
+        }
+        else if (config.soakDurationSec > 0)
+        {
+            runSoakTest(config);
+        }
+        else if (config.energySearch)
+        {
+            runEnergySearch(config);
+        }
+        else if (config.cacheSweep)
+        {
+            runCacheSweep(config);
+        }
+        else if (config.sectorIo)
+        {
+            runSectorIoBenchmark(config);
+        }
+        else if (config.smallMessages)
+        {
+            runSmallMessages(config);
+            printKeyScheduleCacheStats();
+        }
+        else if (config.keyRotationBytes > 0)
+        {
+            runKeyRotation(config);
+        }
+        else if (config.evpStudy)
+        {
+            runEvpStudy(config);
+        }
+        else
+        {
+            runBenchmarks(config);
+            printKeyScheduleCacheStats();
+            if (!config.compareFile.empty())
+                return runComparison(config);
+        }
     }
     catch (const std::exception &e)
     {